@@ -0,0 +1,353 @@
+#include "CYCoroutine/CYCoroutine.hpp"
+#include "CYCoroutine/Results/Impl/CYCountingSemaphore.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+CYCOROUTINE_NAMESPACE_USE;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double ElapsedUs(Clock::time_point tpStart)
+{
+    return std::chrono::duration<double, std::micro>(Clock::now() - tpStart).count();
+}
+
+void Report(const char* pszName, double dUs, size_t nOps)
+{
+    std::cout << "  " << pszName << ": " << dUs / 1000.0 << " ms, " << dUs * 1000.0 / static_cast<double>(nOps) << " ns/op" << std::endl;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Reference semaphore the way it is usually written by hand: a mutex, a
+// condition variable and a counter.
+class CYMutexSemaphore
+{
+public:
+    explicit CYMutexSemaphore(ptrdiff_t nDesired = 0)
+        : m_nCount(nDesired)
+    {
+    }
+
+    void acquire()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this] { return m_nCount > 0; });
+        --m_nCount;
+    }
+
+    void release(ptrdiff_t nUpdate = 1)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_nCount += nUpdate;
+        }
+        m_condition.notify_all();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    ptrdiff_t m_nCount;
+};
+
+// Uncontended release/acquire pairs on one thread, then a two-thread ping-pong
+// where every acquire has to wait for the other thread's release (wake-up path).
+template<class SEMAPHORE>
+void BenchSemaphoreType(const char* pszName)
+{
+    std::cout << pszName << std::endl;
+
+    constexpr size_t nPairs = 2'000'000;
+    SEMAPHORE objSem(0);
+    auto tpStart = Clock::now();
+    for (size_t i = 0; i < nPairs; ++i)
+    {
+        objSem.release();
+        objSem.acquire();
+    }
+    Report("uncontended release+acquire", ElapsedUs(tpStart), nPairs);
+
+    constexpr size_t nRounds = 20'000;
+    SEMAPHORE objPing(0);
+    SEMAPHORE objPong(0);
+    tpStart = Clock::now();
+    std::thread thPeer([&] {
+        for (size_t i = 0; i < nRounds; ++i)
+        {
+            objPing.acquire();
+            objPong.release();
+        }
+        });
+    for (size_t i = 0; i < nRounds; ++i)
+    {
+        objPing.release();
+        objPong.acquire();
+    }
+    thPeer.join();
+    Report("ping-pong round trip", ElapsedUs(tpStart), nRounds);
+}
+
+void BenchSemaphore()
+{
+    std::cout << "== semaphore ==" << std::endl;
+    BenchSemaphoreType<CYCountingSemaphore<>>("CYCountingSemaphore");
+    BenchSemaphoreType<CYMutexSemaphore>("mutex + condition_variable");
+}
+
+template<class RUN_TYPE>
+double MedianUs(RUN_TYPE funcRun)
+{
+    std::vector<double> lstUs;
+    for (int i = 0; i < 9; ++i)
+    {
+        lstUs.emplace_back(funcRun());
+    }
+
+    std::sort(lstUs.begin(), lstUs.end());
+    return lstUs[lstUs.size() / 2];
+}
+
+// Waits for nResults results and sums their values, through WhenALL() plus Get() on every
+// element or through WhenALLValues(). The results run on a manual executor once the wait is
+// set up, so every one of them is still pending when it registers.
+template<bool VALUES>
+double RunWhenALL(const SharePtr<CYManualExecutor>& ptrManual, size_t nResults)
+{
+    std::vector<CYResult<int64_t>> lstResults;
+    lstResults.reserve(nResults);
+    for (size_t i = 0; i < nResults; ++i)
+    {
+        lstResults.emplace_back(ptrManual->Submit([i] { return static_cast<int64_t>(i); }));
+    }
+
+    int64_t nSum = 0;
+    const auto tpStart = Clock::now();
+    if constexpr (VALUES)
+    {
+        auto result = WhenALLValues(CYInlineCoro(), lstResults.begin(), lstResults.end()).Run();
+        ptrManual->Loop(nResults);
+        for (const auto nValue : result.Get())
+        {
+            nSum += nValue;
+        }
+    }
+    else
+    {
+        auto result = WhenALL(CYInlineCoro(), lstResults.begin(), lstResults.end()).Run();
+        ptrManual->Loop(nResults);
+        for (auto& element : result.Get())
+        {
+            nSum += element.Get();
+        }
+    }
+
+    const auto dUs = ElapsedUs(tpStart);
+    return nSum == static_cast<int64_t>(nResults * (nResults - 1) / 2) ? dUs : -1.0;
+}
+
+void BenchWhenALL()
+{
+    std::cout << "== WhenALL over a range (median of 9) ==" << std::endl;
+
+    const auto ptrManual = CYCoroutineEngine::GetInstance()->MakeManualExecutor();
+    for (const size_t nResults : { 10'000, 100'000 })
+    {
+        std::cout << nResults << " results" << std::endl;
+        Report("WhenALL + Get", MedianUs([&] { return RunWhenALL<false>(ptrManual, nResults); }), nResults);
+        Report("WhenALLValues", MedianUs([&] { return RunWhenALL<true>(ptrManual, nResults); }), nResults);
+    }
+
+    ptrManual->ShutDown();
+}
+
+// One reader: nRounds times take the lock, spend nHoldUs inside, let it go. The hold blocks the
+// worker like a synchronous read would, so how many readers overlap is bounded by the workers.
+template<class LOCK_FUNC_TYPE>
+CYResult<void> LockHolder(SharePtr<CYExecutor> ptrExecutor, LOCK_FUNC_TYPE funcLock, size_t nRounds, int64_t nHoldUs)
+{
+    co_await ResumeOn(ptrExecutor);
+    for (size_t i = 0; i < nRounds; ++i)
+    {
+        auto objGuard = co_await funcLock();
+        if (nHoldUs != 0)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(nHoldUs));
+        }
+    }
+}
+
+template<class LOCK_FUNC_TYPE>
+double RunLockHolders(const SharePtr<CYExecutor>& ptrExecutor, LOCK_FUNC_TYPE funcLock, size_t nHolders, size_t nRounds, int64_t nHoldUs)
+{
+    std::vector<CYResult<void>> lstHolders;
+    lstHolders.reserve(nHolders);
+
+    const auto tpStart = Clock::now();
+    for (size_t i = 0; i < nHolders; ++i)
+    {
+        lstHolders.emplace_back(LockHolder(ptrExecutor, funcLock, nRounds, nHoldUs));
+    }
+    for (auto& result : lstHolders)
+    {
+        result.Get();
+    }
+
+    return ElapsedUs(tpStart);
+}
+
+// One reader per pool worker, for pools of 1 to 8 workers. With a hold that blocks the worker,
+// shared ownership lets the readers overlap and the run time stays flat as workers are added,
+// exclusive ownership serializes them and it grows with the worker count. Without a hold it
+// times the lock itself on the engine's pool.
+void BenchSharedLock()
+{
+    std::cout << "== shared lock ==" << std::endl;
+
+    constexpr size_t nRounds = 50;
+    constexpr int64_t nHoldUs = 500;
+    for (const size_t nWorkers : { 1, 2, 4, 8 })
+    {
+        const auto ptrPool = CYCoroutineEngine::GetInstance()->MakeExecutor<CYThreadPoolExecutor>("benchmark pool", nWorkers, milliseconds(60'000));
+        CYAsyncSharedLock objSharedLock;
+        CAsyncLock objLock;
+
+        std::cout << nWorkers << " workers, " << nWorkers << " readers x " << nRounds << " holds of " << nHoldUs << " us" << std::endl;
+        Report("CYAsyncSharedLock::LockShared", RunLockHolders(ptrPool, [&] { return objSharedLock.LockShared(ptrPool); }, nWorkers, nRounds, nHoldUs), nWorkers * nRounds);
+        Report("CYAsyncSharedLock::Lock", RunLockHolders(ptrPool, [&] { return objSharedLock.Lock(ptrPool); }, nWorkers, nRounds, nHoldUs), nWorkers * nRounds);
+        Report("CAsyncLock::Lock", RunLockHolders(ptrPool, [&] { return objLock.Lock(ptrPool); }, nWorkers, nRounds, nHoldUs), nWorkers * nRounds);
+    }
+
+    const auto ptrPool = CYThreadPoolCoro();
+    const auto nWorkers = static_cast<size_t>(std::max(ptrPool->MaxConcurrencyLevel(), 1));
+    CYAsyncSharedLock objSharedLock;
+    CAsyncLock objLock;
+
+    constexpr size_t nEmptyRounds = 100'000;
+    std::cout << nWorkers << " workers, " << nWorkers << " readers x " << nEmptyRounds << " empty holds" << std::endl;
+    Report("CYAsyncSharedLock::LockShared", RunLockHolders(ptrPool, [&] { return objSharedLock.LockShared(ptrPool); }, nWorkers, nEmptyRounds, 0), nWorkers * nEmptyRounds);
+    Report("CAsyncLock::Lock", RunLockHolders(ptrPool, [&] { return objLock.Lock(ptrPool); }, nWorkers, nEmptyRounds, 0), nWorkers * nEmptyRounds);
+}
+
+// Waits until a marker timer queued after everything else fires, the queue thread has then
+// worked through all requests before it.
+void DrainTimerQueue(CYTimerQueue& objQueue, const SharePtr<CYExecutor>& ptrExecutor)
+{
+    std::atomic_bool bFired{ false };
+    auto objMarker = objQueue.MakeOneShotTimer(milliseconds(0), ptrExecutor, [&bFired] { bFired.store(true); });
+    while (!bFired.load())
+    {
+        std::this_thread::yield();
+    }
+}
+
+// With a resident population of far timers (e.g. timeouts that rarely expire): adds and cancels
+// more of them and times the queue thread working through the requests, lets a batch spread over 100 ms expire and reports the worst lateness, and
+// checks that a periodic timer keeps its period.
+void BenchTimerBackend(const char* pszName, ETimerQueueBackend eBackend)
+{
+    std::cout << pszName << std::endl;
+
+    constexpr size_t nResident = 200'000;
+    constexpr size_t nTimers = 100'000;
+    const auto ptrExecutor = CYInlineCoro();
+    const auto ptrQueue = MakeShared<CYTimerQueue>(milliseconds(60'000), FuncThreadDelegate{}, FuncThreadDelegate{}, eBackend);
+
+    std::vector<CYTimer> lstResident;
+    lstResident.reserve(nResident);
+    for (size_t i = 0; i < nResident; ++i)
+    {
+        lstResident.emplace_back(ptrQueue->MakeOneShotTimer(milliseconds(60'000 + i % 600'000), ptrExecutor, [] {}));
+    }
+    DrainTimerQueue(*ptrQueue, ptrExecutor);
+
+    // the inline executor runs timer callbacks on the queue thread: a callback holding it lets
+    // the requests pile up, then the backend works through them in one batch.
+    std::atomic_bool bHold{ true };
+    std::atomic_bool bHeld{ false };
+    auto objHold = ptrQueue->MakeOneShotTimer(milliseconds(0), ptrExecutor, [&bHold, &bHeld] {
+        bHeld.store(true);
+        while (bHold.load())
+        {
+            std::this_thread::yield();
+        }
+        });
+    while (!bHeld.load())
+    {
+        std::this_thread::yield();
+    }
+
+    auto tpStart = Clock::now();
+    for (size_t i = 0; i < nTimers; ++i)
+    {
+        auto objTimer = ptrQueue->MakeOneShotTimer(milliseconds(10'000 + i % 50'000), ptrExecutor, [] {});
+        objTimer.Cancel();
+    }
+    Report("add + cancel, caller side", ElapsedUs(tpStart), nTimers);
+
+    tpStart = Clock::now();
+    bHold.store(false);
+    DrainTimerQueue(*ptrQueue, ptrExecutor);
+    Report("add + cancel, queue thread", ElapsedUs(tpStart), nTimers);
+
+    std::atomic_size_t nFired{ 0 };
+    std::atomic<int64_t> nMaxLateUs{ 0 };
+    std::vector<CYTimer> lstTimers;
+    lstTimers.reserve(nTimers);
+    for (size_t i = 0; i < nTimers; ++i)
+    {
+        const auto nDue = milliseconds(200 + i % 100);
+        lstTimers.emplace_back(ptrQueue->MakeOneShotTimer(nDue, ptrExecutor, [&nFired, &nMaxLateUs, tpDue = Clock::now() + nDue] {
+            const auto nLateUs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - tpDue).count();
+            auto nMax = nMaxLateUs.load();
+            while (nLateUs > nMax && !nMaxLateUs.compare_exchange_weak(nMax, nLateUs));
+            nFired.fetch_add(1);
+            }));
+    }
+    while (nFired.load() != nTimers)
+    {
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+    std::cout << "  expire: " << nTimers << " timers, worst lateness " << nMaxLateUs.load() / 1000.0 << " ms" << std::endl;
+    lstTimers.clear();
+
+    std::atomic_size_t nTicks{ 0 };
+    auto objPeriodic = ptrQueue->MakeTimer(milliseconds(10), milliseconds(10), ptrExecutor, [&nTicks] { nTicks.fetch_add(1); });
+    std::this_thread::sleep_for(milliseconds(1'005));
+    objPeriodic.Cancel();
+    std::cout << "  periodic: 10 ms timer fired " << nTicks.load() << " times in 1005 ms" << std::endl;
+}
+
+void BenchTimerWheel()
+{
+    std::cout << "== timer queue ==" << std::endl;
+    BenchTimerBackend("BACKEND_TIMER_WHEEL", ETimerQueueBackend::BACKEND_TIMER_WHEEL);
+    BenchTimerBackend("BACKEND_TIMER_SET", ETimerQueueBackend::BACKEND_TIMER_SET);
+}
+}
+
+// Usage: CYCoroutineBenchmark [semaphore|whenall|sharedlock|timer]
+// Without an argument every benchmark runs.
+int main(int argc, char* argv[])
+{
+    const char* pszOnly = argc > 1 ? argv[1] : nullptr;
+    auto Selected = [pszOnly](const char* pszName) { return pszOnly == nullptr || std::strcmp(pszOnly, pszName) == 0; };
+
+    if (Selected("semaphore")) BenchSemaphore();
+    if (Selected("whenall")) BenchWhenALL();
+    if (Selected("sharedlock")) BenchSharedLock();
+    if (Selected("timer")) BenchTimerWheel();
+
+    CYCoroFree();
+
+    return 0;
+}
@@ -53,17 +53,29 @@
 #include "CYCoroutine/Executors/CYThreadExecutor.hpp"
 #include "CYCoroutine/Executors/CYThreadPoolExecutor.hpp"
 #include "CYCoroutine/Executors/CYWorkerThreadExecutor.hpp"
+#include "CYCoroutine/Results/CYAsyncGenerator.hpp"
+#include "CYCoroutine/Results/CYCompletionQueue.hpp"
 #include "CYCoroutine/Results/CYGenerator.hpp"
 #include "CYCoroutine/Results/CYLazyResult.hpp"
 #include "CYCoroutine/Results/CYMakeResult.hpp"
 #include "CYCoroutine/Results/CYResult.hpp"
 #include "CYCoroutine/Results/CYResumeOn.hpp"
+#include "CYCoroutine/Results/CYSelect.hpp"
 #include "CYCoroutine/Results/CYSharedResult.hpp"
 #include "CYCoroutine/Results/CYSharedResultAwaitable.hpp"
+#include "CYCoroutine/Results/CYTaskGroup.hpp"
 #include "CYCoroutine/Results/CYWhenResult.hpp"
 #include "CYCoroutine/Engine/CYCoroutineEngine.hpp"
+#include "CYCoroutine/Threads/CYAsyncBarrier.hpp"
 #include "CYCoroutine/Threads/CYAsyncCondition.hpp"
+#include "CYCoroutine/Threads/CYAsyncEvent.hpp"
+#include "CYCoroutine/Threads/CYAsyncLatch.hpp"
 #include "CYCoroutine/Threads/CYAsyncLock.hpp"
+#include "CYCoroutine/Threads/CYAsyncSemaphore.hpp"
+#include "CYCoroutine/Threads/CYAsyncSharedLock.hpp"
+#include "CYCoroutine/Threads/CYAsyncWaitStack.hpp"
+#include "CYCoroutine/Threads/CYCancellation.hpp"
+#include "CYCoroutine/Threads/CYChannel.hpp"
 #include "CYCoroutine/Timers/CYTimer.hpp"
 #include "CYCoroutine/Timers/CYTimerQueue.hpp"
 
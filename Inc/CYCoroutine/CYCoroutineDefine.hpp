@@ -132,6 +132,15 @@ enum class EResultStatus
     STATUS_RESULT_EXCEPTION = 0x02,
 };
 
+// How CYTimerQueue keeps its timers.
+enum class ETimerQueueBackend
+{
+    // ordered by deadline in a multiset, O(log n) per add / cancel.
+    BACKEND_TIMER_SET,
+    // hierarchical timing wheel with millisecond ticks, O(1) add / cancel / expire.
+    BACKEND_TIMER_WHEEL
+};
+
 CYCOROUTINE_NAMESPACE_END
 
 #endif //__CY_COROUTINE_DEFINE_CORO_HPP__
\ No newline at end of file
@@ -78,6 +78,8 @@ public:
     size_t maxBackgroundThreads;
     milliseconds maxBackgroundExecutorWaitTime;
     milliseconds maxTimerQueueWaitTime;
+    ETimerQueueBackend timerQueueBackend;
+    bool timerQueueWorkerLocal;
 
     FuncThreadDelegate funStartedCallBack;
     FuncThreadDelegate funTerminatedCallBack;
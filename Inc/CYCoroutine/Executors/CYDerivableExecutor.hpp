@@ -70,6 +70,12 @@ struct CYCOROUTINE_API CYDerivableExecutor : public CYExecutor
         return DoSubmit<CONCRETE_EXECUTOR_TYPE>(std::forward<CALLABLE_TYPE>(callable), std::forward<ARGS_TYPES>(args)...);
     }
 
+    template<class CALLABLE_TYPE, class... ARGS_TYPES>
+    auto Submit(CYCancellationToken token, CALLABLE_TYPE&& callable, ARGS_TYPES&&... args)
+    {
+        return DoSubmitCancellable<CONCRETE_EXECUTOR_TYPE>(std::move(token), std::forward<CALLABLE_TYPE>(callable), std::forward<ARGS_TYPES>(args)...);
+    }
+
     template<class CALLABLE_TYPE>
     void BulkPost(std::span<CALLABLE_TYPE> lstCallable)
     {
@@ -81,6 +87,18 @@ struct CYCOROUTINE_API CYDerivableExecutor : public CYExecutor
     {
         return DoBulkSubmit<CONCRETE_EXECUTOR_TYPE>(lstCallable);
     }
+
+    template<class CALLABLE_TYPE, class RETURN_TYPE = std::invoke_result_t<CALLABLE_TYPE>>
+    CYResult<CYChunkedResult<RETURN_TYPE>> BulkSubmitChunked(std::span<CALLABLE_TYPE> lstCallable, size_t nChunkSize = 0)
+    {
+        return DoBulkSubmitChunked<CONCRETE_EXECUTOR_TYPE>(lstCallable, nChunkSize);
+    }
+
+    template<class CALLABLE_TYPE, class TYPE, class REDUCE_TYPE>
+    CYResult<TYPE> BulkReduceChunked(std::span<CALLABLE_TYPE> lstCallable, TYPE init, REDUCE_TYPE reduce, size_t nChunkSize = 0)
+    {
+        return DoBulkReduceChunked<CONCRETE_EXECUTOR_TYPE>(lstCallable, std::move(init), std::move(reduce), nChunkSize);
+    }
 };
 
 CYCOROUTINE_NAMESPACE_END
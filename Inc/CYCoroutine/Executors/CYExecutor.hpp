@@ -46,7 +46,11 @@
 #include "CYCoroutine/CYCoroutineDefine.hpp"
 #include "CYCoroutine/Results/CYResult.hpp"
 #include "CYCoroutine/Task/CYTask.hpp"
+#include "CYCoroutine/Threads/CYCancellation.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
@@ -55,6 +59,9 @@
 
 CYCOROUTINE_NAMESPACE_BEGIN
 
+template<class RETURN_TYPE>
+using CYChunkedResult = std::conditional_t<std::is_void_v<RETURN_TYPE>, void, std::vector<RETURN_TYPE>>;
+
 /*[[noreturn]]*/ CYCOROUTINE_API void ThrowRuntimeShutdownException(std::string_view strExecutorName);
 CYCOROUTINE_API std::string MakeExecutorWorkerName(std::string_view strExecutorName);
 
@@ -90,6 +97,13 @@ public:
         return DoSubmit<CYExecutor>(std::forward<CALLABLE_TYPE>(callable), std::forward<ARGS_TYPES>(args)...);
     }
 
+    // the callable is skipped and the result fails with operation_canceled if token is cancelled before it starts.
+    template<class CALLABLE_TYPE, class... ARGS_TYPES>
+    auto Submit(CYCancellationToken token, CALLABLE_TYPE&& callable, ARGS_TYPES&&... args)
+    {
+        return DoSubmitCancellable<CYExecutor>(std::move(token), std::forward<CALLABLE_TYPE>(callable), std::forward<ARGS_TYPES>(args)...);
+    }
+
     template<class CALLABLE_TYPE>
     void BulkPost(std::span<CALLABLE_TYPE> lstCallable)
     {
@@ -102,6 +116,18 @@ public:
         return DoBulkSubmit<CYExecutor>(lstCallable);
     }
 
+    template<class CALLABLE_TYPE, class RETURN_TYPE = std::invoke_result_t<CALLABLE_TYPE>>
+    CYResult<CYChunkedResult<RETURN_TYPE>> BulkSubmitChunked(std::span<CALLABLE_TYPE> lstCallable, size_t nChunkSize = 0)
+    {
+        return DoBulkSubmitChunked<CYExecutor>(lstCallable, nChunkSize);
+    }
+
+    template<class CALLABLE_TYPE, class TYPE, class REDUCE_TYPE>
+    CYResult<TYPE> BulkReduceChunked(std::span<CALLABLE_TYPE> lstCallable, TYPE init, REDUCE_TYPE reduce, size_t nChunkSize = 0)
+    {
+        return DoBulkReduceChunked<CYExecutor>(lstCallable, std::move(init), std::move(reduce), nChunkSize);
+    }
+
 protected:
     template<class EXECUTOR_TYPE, class CALLABLE_TYPE, class... ARGS_TYPES>
     void DoPost(CALLABLE_TYPE&& callable, ARGS_TYPES&&... args)
@@ -120,6 +146,15 @@ protected:
         return SubmitBridge<RETURN_TYPE>({}, *static_cast<EXECUTOR_TYPE*>(this), std::forward<CALLABLE_TYPE>(callable), std::forward<ARGS_TYPES>(args)...);
     }
 
+    template<class EXECUTOR_TYPE, class CALLABLE_TYPE, class... ARGS_TYPES>
+    auto DoSubmitCancellable(CYCancellationToken token, CALLABLE_TYPE&& callable, ARGS_TYPES&&... args)
+    {
+        static_assert(std::is_invocable_v<CALLABLE_TYPE, ARGS_TYPES...>, "CYExecutor::submit - <<CALLABLE_TYPE>> is not invokable with <<ARGS_TYPES...>>");
+
+        using RETURN_TYPE = typename std::invoke_result_t<CALLABLE_TYPE, ARGS_TYPES...>;
+        return SubmitCancellableBridge<RETURN_TYPE>({}, *static_cast<EXECUTOR_TYPE*>(this), std::move(token), std::forward<CALLABLE_TYPE>(callable), std::forward<ARGS_TYPES>(args)...);
+    }
+
     template<class EXECUTOR_TYPE, class CALLABLE_TYPE>
     void DoBulkPost(std::span<CALLABLE_TYPE> lstCallable)
     {
@@ -157,6 +192,28 @@ protected:
         return results;
     }
 
+    /*
+     * Chunked bulk submission: the callables are cut into chunks, every chunk runs as one CYTask and
+     * the whole batch completes a single CYResult, so there is no coroutine frame per callable.
+     * nChunkSize == 0 picks about four chunks per unit of MaxConcurrencyLevel().
+     */
+    template<class EXECUTOR_TYPE, class CALLABLE_TYPE, class RETURN_TYPE = std::invoke_result_t<CALLABLE_TYPE>>
+    CYResult<CYChunkedResult<RETURN_TYPE>> DoBulkSubmitChunked(std::span<CALLABLE_TYPE> lstCallable, size_t nChunkSize)
+    {
+        std::vector<CALLABLE_TYPE> lstOwned(std::make_move_iterator(lstCallable.begin()), std::make_move_iterator(lstCallable.end()));
+        const auto nSize = lstOwned.size();
+        return BulkSubmitChunkedBridge<EXECUTOR_TYPE, CALLABLE_TYPE, RETURN_TYPE>(*static_cast<EXECUTOR_TYPE*>(this), std::move(lstOwned), ChunkSize(nSize, nChunkSize));
+    }
+
+    // reduce must be associative and accept (TYPE, RETURN_TYPE) as well as (TYPE, TYPE).
+    template<class EXECUTOR_TYPE, class CALLABLE_TYPE, class TYPE, class REDUCE_TYPE>
+    CYResult<TYPE> DoBulkReduceChunked(std::span<CALLABLE_TYPE> lstCallable, TYPE init, REDUCE_TYPE reduce, size_t nChunkSize)
+    {
+        std::vector<CALLABLE_TYPE> lstOwned(std::make_move_iterator(lstCallable.begin()), std::make_move_iterator(lstCallable.end()));
+        const auto nSize = lstOwned.size();
+        return BulkReduceChunkedBridge<EXECUTOR_TYPE, CALLABLE_TYPE, TYPE, REDUCE_TYPE>(*static_cast<EXECUTOR_TYPE*>(this), std::move(lstOwned), ChunkSize(nSize, nChunkSize), std::move(init), std::move(reduce));
+    }
+
 private:
     template<class RETURN_TYPE, class EXECUTOR_TYPE, class CALLABLE_TYPE, class... ARGS_TYPES>
     static CYResult<RETURN_TYPE> SubmitBridge(CYExecutorTag, EXECUTOR_TYPE&, CALLABLE_TYPE callable, ARGS_TYPES... args)
@@ -164,6 +221,13 @@ private:
         co_return callable(args...);
     }
 
+    template<class RETURN_TYPE, class EXECUTOR_TYPE, class CALLABLE_TYPE, class... ARGS_TYPES>
+    static CYResult<RETURN_TYPE> SubmitCancellableBridge(CYExecutorTag, EXECUTOR_TYPE&, CYCancellationToken token, CALLABLE_TYPE callable, ARGS_TYPES... args)
+    {
+        token.ThrowIfCancelled();
+        co_return callable(args...);
+    }
+
     struct CYAccumulatingAwaitable
     {
         std::vector<CYTask>& m_lstAccumulator;
@@ -204,6 +268,230 @@ private:
         co_await CYAccumulatingAwaitable(lstAccumulator);
         co_return callable();
     }
+
+    size_t ChunkSize(size_t nSize, size_t nChunkSize) const noexcept
+    {
+        if (nChunkSize != 0)
+        {
+            return nChunkSize;
+        }
+
+        const auto nChunkCount = static_cast<size_t>(std::max(MaxConcurrencyLevel(), 1)) * 4;
+        return std::max<size_t>(1, (nSize + nChunkCount - 1) / nChunkCount);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // Shared by the chunk tasks of one batch, lives in the bridge coroutine frame.
+    struct CYChunkedJoin
+    {
+        CYCountdownContext objCountdown;
+        std::atomic_bool bFailed{ false };
+        std::atomic_bool bInterrupted{ false };
+        std::exception_ptr pException;
+
+        CYChunkedJoin(size_t nChunkCount) noexcept
+            : objCountdown(nChunkCount)
+        {
+        }
+
+        void Fail(std::exception_ptr pError) noexcept
+        {
+            if (!bFailed.exchange(true, std::memory_order_acq_rel))
+            {
+                pException = std::move(pError);
+            }
+        }
+    };
+
+    // Runs one chunk and counts it down; a task dropped without running counts down as interrupted.
+    template<class CHUNK_TYPE>
+    class CYChunkFunctor
+    {
+    public:
+        CYChunkFunctor(CYChunkedJoin& objJoin, CHUNK_TYPE& funcChunk, size_t nChunk) noexcept
+            : m_pJoin(&objJoin)
+            , m_pChunk(&funcChunk)
+            , m_nChunk(nChunk)
+        {
+        }
+
+        CYChunkFunctor(CYChunkFunctor&& rhs) noexcept
+            : m_pJoin(std::exchange(rhs.m_pJoin, nullptr))
+            , m_pChunk(rhs.m_pChunk)
+            , m_nChunk(rhs.m_nChunk)
+        {
+        }
+
+        ~CYChunkFunctor() noexcept
+        {
+            if (m_pJoin == nullptr)
+            {
+                return;
+            }
+
+            m_pJoin->bInterrupted.store(true, std::memory_order_relaxed);
+            m_pJoin->objCountdown.Arrive();
+        }
+
+        void operator()() noexcept
+        {
+            auto pJoin = std::exchange(m_pJoin, nullptr);
+            if (!pJoin->bFailed.load(std::memory_order_relaxed))
+            {
+                try
+                {
+                    (*m_pChunk)(m_nChunk);
+                }
+                catch (...)
+                {
+                    pJoin->Fail(std::current_exception());
+                }
+            }
+
+            // may resume (and destroy) the bridge coroutine, nothing of it is touched afterwards.
+            pJoin->objCountdown.Arrive();
+        }
+
+    private:
+        CYChunkedJoin* m_pJoin;
+        CHUNK_TYPE* m_pChunk;
+        size_t m_nChunk;
+    };
+
+    template<class EXECUTOR_TYPE, class CHUNK_TYPE>
+    struct CYChunkedAwaitable
+    {
+        EXECUTOR_TYPE& m_executor;
+        CYChunkedJoin& m_objJoin;
+        CHUNK_TYPE& m_funcChunk;
+        size_t m_nChunkCount;
+
+        bool await_ready() const noexcept
+        {
+            return m_nChunkCount == 0;
+        }
+
+        bool await_suspend(coroutine_handle<void> handleCoro) noexcept
+        {
+            m_objJoin.objCountdown.SetCaller(handleCoro);
+
+            size_t nBuilt = 0;
+            try
+            {
+                std::vector<CYTask> tasks;
+                tasks.reserve(m_nChunkCount);
+
+                while (nBuilt < m_nChunkCount)
+                {
+                    // from here on the functor arrives exactly once: when it runs or when it is dropped.
+                    CYChunkFunctor<CHUNK_TYPE> objFunctor(m_objJoin, m_funcChunk, nBuilt++);
+                    tasks.emplace_back(std::move(objFunctor));
+                }
+
+                std::span<CYTask> span = tasks;
+                m_executor.Enqueue(span);
+            }
+            catch (...)
+            {
+                // built functors that never got enqueued count themselves down in ~CYChunkFunctor,
+                // the chunks that were never built are counted down by Suspend below.
+                if (nBuilt != m_nChunkCount)
+                {
+                    m_objJoin.bInterrupted.store(true, std::memory_order_relaxed);
+                }
+            }
+
+            return m_objJoin.objCountdown.Suspend(m_nChunkCount - nBuilt);
+        }
+
+        void await_resume() const
+        {
+            IfTrueThrow(m_objJoin.bInterrupted.load(std::memory_order_relaxed), TEXT("await_resume Interrupted."));
+
+            if (m_objJoin.pException != nullptr)
+            {
+                std::rethrow_exception(m_objJoin.pException);
+            }
+        }
+    };
+
+    template<class EXECUTOR_TYPE, class CALLABLE_TYPE, class RETURN_TYPE>
+    static CYResult<CYChunkedResult<RETURN_TYPE>> BulkSubmitChunkedBridge(EXECUTOR_TYPE& executor, std::vector<CALLABLE_TYPE> lstCallable, size_t nChunkSize)
+    {
+        const auto nSize = lstCallable.size();
+        const auto nChunkCount = (nSize + nChunkSize - 1) / nChunkSize;
+        using CHUNK_VALUE_TYPE = std::conditional_t<std::is_void_v<RETURN_TYPE>, char, RETURN_TYPE>;
+        std::vector<std::vector<CHUNK_VALUE_TYPE>> lstChunkResults(std::is_void_v<RETURN_TYPE> ? 0 : nChunkCount);
+
+        auto funcChunk = [&](size_t nChunk)
+            {
+                const auto nBegin = nChunk * nChunkSize;
+                const auto nEnd = std::min(nBegin + nChunkSize, nSize);
+
+                if constexpr (std::is_void_v<RETURN_TYPE>)
+                {
+                    for (auto i = nBegin; i < nEnd; i++)
+                    {
+                        lstCallable[i]();
+                    }
+                }
+                else
+                {
+                    auto& lstOut = lstChunkResults[nChunk];
+                    lstOut.reserve(nEnd - nBegin);
+                    for (auto i = nBegin; i < nEnd; i++)
+                    {
+                        lstOut.emplace_back(lstCallable[i]());
+                    }
+                }
+            };
+
+        CYChunkedJoin objJoin(nChunkCount);
+        co_await CYChunkedAwaitable<EXECUTOR_TYPE, decltype(funcChunk)> {executor, objJoin, funcChunk, nChunkCount};
+
+        if constexpr (!std::is_void_v<RETURN_TYPE>)
+        {
+            std::vector<RETURN_TYPE> results;
+            results.reserve(nSize);
+            for (auto& lstChunk : lstChunkResults)
+            {
+                std::move(lstChunk.begin(), lstChunk.end(), std::back_inserter(results));
+            }
+
+            co_return std::move(results);
+        }
+    }
+
+    template<class EXECUTOR_TYPE, class CALLABLE_TYPE, class TYPE, class REDUCE_TYPE>
+    static CYResult<TYPE> BulkReduceChunkedBridge(EXECUTOR_TYPE& executor, std::vector<CALLABLE_TYPE> lstCallable, size_t nChunkSize, TYPE init, REDUCE_TYPE reduce)
+    {
+        const auto nSize = lstCallable.size();
+        const auto nChunkCount = (nSize + nChunkSize - 1) / nChunkSize;
+        std::vector<std::optional<TYPE>> lstPartials(nChunkCount);
+
+        auto funcChunk = [&](size_t nChunk)
+            {
+                const auto nBegin = nChunk * nChunkSize;
+                const auto nEnd = std::min(nBegin + nChunkSize, nSize);
+
+                auto& partial = lstPartials[nChunk];
+                partial.emplace(lstCallable[nBegin]());
+                for (auto i = nBegin + 1; i < nEnd; i++)
+                {
+                    partial = reduce(std::move(*partial), lstCallable[i]());
+                }
+            };
+
+        CYChunkedJoin objJoin(nChunkCount);
+        co_await CYChunkedAwaitable<EXECUTOR_TYPE, decltype(funcChunk)> {executor, objJoin, funcChunk, nChunkCount};
+
+        for (auto& partial : lstPartials)
+        {
+            init = reduce(std::move(init), std::move(*partial));
+        }
+
+        co_return std::move(init);
+    }
 };
 
 CYCOROUTINE_NAMESPACE_END
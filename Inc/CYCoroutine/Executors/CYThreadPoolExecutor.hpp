@@ -47,6 +47,7 @@
 #include "CYCoroutine/Executors/CYDerivableExecutor.hpp"
 #include "CYCoroutine/Threads/CYCacheLine.hpp"
 #include "CYCoroutine/Threads/CYThread.hpp"
+#include "CYCoroutine/Timers/CYTimer.hpp"
 
 #include <deque>
 #include <mutex>
@@ -91,6 +92,8 @@ class CYCOROUTINE_API alignas(CACHE_LINE_ALIGNMENT) CYThreadPoolExecutor final
     : public CYDerivableExecutor<CYThreadPoolExecutor>
 {
     friend class CYThreadPoolWorker;
+    friend class CYTimer;
+    friend class CYTimerQueue;
  public:
     CYThreadPoolExecutor(std::string_view strPoolName, size_t nPoolSize, std::chrono::milliseconds maxIdleTime, const FuncThreadDelegate& funStartedCallBack = {}, const FuncThreadDelegate& funTerminatedCallBack = {});
     virtual ~CYThreadPoolExecutor() override;
@@ -112,6 +115,14 @@ private:
 
     CYThreadPoolWorker& WorkerAt(size_t index) noexcept;
 
+    // the pool the calling thread works for, nullptr on any other thread.
+    static CYThreadPoolExecutor* CurrentPool() noexcept;
+
+    // worker-local timers: kept and fired by the calling worker between its tasks, a cancel
+    // from another thread is handed to the owning worker.
+    void AddLocalTimer(const SharePtr<CYTimerStateBase>& ptrTimer);
+    void RemoveLocalTimer(SharePtr<CYTimerStateBase> ptrTimer);
+
 private:
     std::vector<CYThreadPoolWorker> m_lstWorkers;
     alignas(CACHE_LINE_ALIGNMENT) CYIdleWorkerSet m_objIdleWorkers;
@@ -0,0 +1,175 @@
+/*
+ * CYCoroutine License
+ * -----------
+ *
+ * CYCoroutine is licensed under the terms of the MIT license reproduced below.
+ * This means that CYCoroutine is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+/*
+ * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ * VERSION:  1.0.0
+ * PURPOSE:  A cross-platform efficient and stable Coroutine library.
+ * CREATION: 2026.10.18
+ * LCHANGE:  2026.10.18
+ * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+ */
+
+#ifndef __CY_ASYNC_GENERATOR_CORO_HPP__
+#define __CY_ASYNC_GENERATOR_CORO_HPP__
+
+#include "CYCoroutine/CYCoroutineDefine.hpp"
+#include "CYCoroutine/Results/Impl/CYAsyncGeneratorState.hpp"
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+/*
+ * Generator whose body may co_await between yields. Consumed from a coroutine, either
+ *     while (auto pValue = co_await gen.Next()) { ... }
+ * or
+ *     for (auto it = co_await gen.begin(); it != gen.end(); co_await ++it) { ... }
+ * Values are yielded by reference, they stay valid until the consumer asks for the next one.
+ * Destroying the generator while it is suspended at a co_yield cancels it: the producer is not
+ * resumed again and its frame, with every local, is destroyed.
+ */
+template<typename TYPE>
+class CYAsyncGenerator
+{
+public:
+    using promise_type = CYAsyncGeneratorState<TYPE>;
+    using iterator = CYAsyncGeneratorIterator<TYPE>;
+    using value_type = typename promise_type::value_type;
+    static_assert(!std::is_same_v<TYPE, void>, "<<TYPE>> can not be void.");
+
+public:
+    CYAsyncGenerator(coroutine_handle<promise_type> handle) noexcept
+        : m_handleCoro(handle)
+    {
+    }
+
+    CYAsyncGenerator(CYAsyncGenerator&& rhs) noexcept
+        : m_handleCoro(std::exchange(rhs.m_handleCoro, {}))
+        , m_bStarted(std::exchange(rhs.m_bStarted, false))
+    {
+    }
+
+    virtual ~CYAsyncGenerator() noexcept
+    {
+        if (static_cast<bool>(m_handleCoro))
+        {
+            m_handleCoro.destroy();
+        }
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return static_cast<bool>(m_handleCoro);
+    }
+
+    // co_await gen.begin();
+    auto begin()
+    {
+        IfTrueThrow(!static_cast<bool>(m_handleCoro), TEXT("CYAsyncGenerator::begin - CYAsyncGenerator is empty."));
+        IfTrueThrow(m_bStarted, TEXT("CYAsyncGenerator::begin - CYAsyncGenerator was already started."));
+
+        m_bStarted = true;
+        return CYBeginAwaitable{ m_handleCoro };
+    }
+
+    static CYAsyncGeneratorEndIterator end() noexcept
+    {
+        return {};
+    }
+
+    // co_await gen.Next(), nullptr once the generator is exhausted.
+    auto Next()
+    {
+        IfTrueThrow(!static_cast<bool>(m_handleCoro), TEXT("CYAsyncGenerator::Next - CYAsyncGenerator is empty."));
+
+        m_bStarted = true;
+        return CYNextAwaitable{ m_handleCoro };
+    }
+
+private:
+    //////////////////////////////////////////////////////////////////////////
+    struct CYResumeAwaitable
+    {
+        coroutine_handle<promise_type> m_handleCoro;
+
+        bool await_ready() const noexcept
+        {
+            return m_handleCoro.done();
+        }
+
+        coroutine_handle<void> await_suspend(coroutine_handle<void> handleConsumer) noexcept
+        {
+            m_handleCoro.promise().SetConsumer(handleConsumer);
+            return m_handleCoro;
+        }
+
+        bool Resumed() const
+        {
+            if (!m_handleCoro.done())
+            {
+                return true;
+            }
+
+            m_handleCoro.promise().throw_if_exception();
+            return false;
+        }
+    };
+
+    struct CYBeginAwaitable : public CYResumeAwaitable
+    {
+        iterator await_resume() const
+        {
+            (void)this->Resumed();
+            return iterator{ this->m_handleCoro };
+        }
+    };
+
+    struct CYNextAwaitable : public CYResumeAwaitable
+    {
+        value_type* await_resume() const
+        {
+            return this->Resumed() ? std::addressof(this->m_handleCoro.promise().value()) : nullptr;
+        }
+    };
+
+private:
+    CYAsyncGenerator(const CYAsyncGenerator& rhs) = delete;
+    CYAsyncGenerator& operator=(CYAsyncGenerator&& rhs) = delete;
+    CYAsyncGenerator& operator=(const CYAsyncGenerator& rhs) = delete;
+
+private:
+    coroutine_handle<promise_type> m_handleCoro;
+    bool m_bStarted = false;
+};
+CYCOROUTINE_NAMESPACE_END
+
+#endif //__CY_ASYNC_GENERATOR_CORO_HPP__
@@ -0,0 +1,318 @@
+/*
+ * CYCoroutine License
+ * -----------
+ *
+ * CYCoroutine is licensed under the terms of the MIT license reproduced below.
+ * This means that CYCoroutine is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+/*
+ * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ * VERSION:  1.0.0
+ * PURPOSE:  A cross-platform efficient and stable Coroutine library.
+ * CREATION: 2026.10.18
+ * LCHANGE:  2026.10.18
+ * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+ */
+
+#ifndef __CY_COMPLETION_QUEUE_CORO_HPP__
+#define __CY_COMPLETION_QUEUE_CORO_HPP__
+
+#include "CYCommon/Common/Exception/CYException.hpp"
+
+#include "CYCoroutine/CYCoroutineDefine.hpp"
+#include "CYCoroutine/Results/CYResult.hpp"
+#include "CYCoroutine/Results/CYWhenResult.hpp"
+#include "CYCoroutine/Results/Impl/CYConsumerContext.hpp"
+
+#include <thread>
+#include <vector>
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+/*
+ * Persistent WhenAny: the results are moved in and registered once, every completion
+ * pushes its index onto a lock-free queue, and co_await Next() hands out the next
+ * finished index in O(1) instead of re-registering the whole range on each call.
+ * The awaiting coroutine is resumed inline by the completing producer.
+ * Only one coroutine may consume a queue at a time.
+ */
+template<class TYPE>
+class CYCompletionQueue
+{
+public:
+    template<class ITERATOR_TYPE>
+    CYCompletionQueue(ITERATOR_TYPE begin, ITERATOR_TYPE end)
+        : m_results(std::make_move_iterator(CheckedBegin(begin, end)), std::make_move_iterator(end))
+        , m_ptrNodes(MakeUnique<CYCompletionNode[]>(m_results.size()))
+        , m_nRemaining(m_results.size())
+    {
+        for (size_t i = 0; i < m_results.size(); i++)
+        {
+            auto& objNode = m_ptrNodes[i];
+            objNode.pContext = &m_objContext;
+
+            if (!CYWhenResultHelper::At(m_results, i).WhenComplete(objNode))
+            {
+                m_objContext.Push(objNode);
+            }
+        }
+    }
+
+    ~CYCompletionQueue() noexcept
+    {
+        // detach from the results still running; a producer that already claimed
+        // its node is waited for until it has queued it.
+        for (size_t i = 0; i < m_results.size(); i++)
+        {
+            auto& objNode = m_ptrNodes[i];
+            if (objNode.bQueued.load(std::memory_order_acquire))
+            {
+                continue;
+            }
+
+            if (static_cast<bool>(m_results[i]) && CYWhenResultHelper::At(m_results, i).TryRewindConsumer())
+            {
+                continue;
+            }
+
+            while (!objNode.bQueued.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    CYCompletionQueue(const CYCompletionQueue&) = delete;
+    CYCompletionQueue& operator=(const CYCompletionQueue&) = delete;
+
+public:
+    //////////////////////////////////////////////////////////////////////////
+    class CYNextAwaitable
+    {
+    public:
+        CYNextAwaitable(CYCompletionQueue& objQueue) noexcept
+            : m_objQueue(objQueue)
+        {
+        }
+
+        bool await_ready() noexcept
+        {
+            m_pNode = m_objQueue.m_objContext.TryPop();
+            return m_pNode != nullptr;
+        }
+
+        bool await_suspend(coroutine_handle<void> handleCaller) noexcept
+        {
+            return m_objQueue.m_objContext.Suspend(handleCaller);
+        }
+
+        size_t await_resume() noexcept
+        {
+            if (m_pNode == nullptr)
+            {
+                m_pNode = m_objQueue.m_objContext.TryPop();
+            }
+
+            assert(m_pNode != nullptr);
+            return m_objQueue.HandOut(*m_pNode);
+        }
+
+    private:
+        CYCompletionQueue& m_objQueue;
+        CYCompletionNode* m_pNode = nullptr;
+    };
+
+    size_t Size() const noexcept
+    {
+        return m_results.size();
+    }
+
+    // results not handed out by Next()/TryNext() yet
+    size_t Remaining() const noexcept
+    {
+        return m_nRemaining;
+    }
+
+    // results still pending keep the queue registered as their consumer, they can only be
+    // inspected. Get() or moving out is allowed once Next()/TryNext() produced the index.
+    const CYResult<TYPE>& operator[](size_t nIndex) const noexcept
+    {
+        assert(nIndex < m_results.size());
+        return m_results[nIndex];
+    }
+
+    CYResult<TYPE>& operator[](size_t nIndex)
+    {
+        assert(nIndex < m_results.size());
+        IfTrueThrow(!m_ptrNodes[nIndex].bHandedOut, TEXT("CYCompletionQueue - the result wasn't handed out by Next()/TryNext() yet."));
+        return m_results[nIndex];
+    }
+
+    const std::vector<CYResult<TYPE>>& Results() const noexcept
+    {
+        return m_results;
+    }
+
+    CYNextAwaitable Next()
+    {
+        IfTrueThrow(m_nRemaining == 0, TEXT("CYCompletionQueue::Next() - no pending results left."));
+        return CYNextAwaitable{ *this };
+    }
+
+    // non-blocking poll, returns false when no further result has finished yet
+    bool TryNext(size_t& nIndex) noexcept
+    {
+        const auto pNode = m_objContext.TryPop();
+        if (pNode == nullptr)
+        {
+            return false;
+        }
+
+        nIndex = HandOut(*pNode);
+        return true;
+    }
+
+private:
+    // Validates the range before anything is moved out of it, so a throwing constructor leaves the caller's results intact.
+    template<class ITERATOR_TYPE>
+    static ITERATOR_TYPE CheckedBegin(ITERATOR_TYPE begin, ITERATOR_TYPE end)
+    {
+        CYWhenResultHelper::IfEmptyThrowRange("CYCompletionQueue - one of the CYResult objects is empty.", begin, end);
+        return begin;
+    }
+
+    size_t HandOut(CYCompletionNode& objNode) noexcept
+    {
+        assert(!objNode.bHandedOut);
+        objNode.bHandedOut = true;
+        --m_nRemaining;
+        return static_cast<size_t>(&objNode - m_ptrNodes.get());
+    }
+
+    std::vector<CYResult<TYPE>> m_results;
+    UniquePtr<CYCompletionNode[]> m_ptrNodes;
+    CYCompletionContext m_objContext;
+    size_t m_nRemaining;
+};
+
+//////////////////////////////////////////////////////////////////////////
+template<class TYPE>
+struct CYWhenEachResult
+{
+    size_t index;
+    CYResult<TYPE> result;
+};
+
+/*
+ * As-completed iteration: each co_await Next() yields the index (in the original range)
+ * and the CYResult of the next finished result. Registration happens once in WhenEach(),
+ * stepping through the cursor does not allocate.
+ */
+template<class TYPE>
+class CYWhenEachCursor
+{
+public:
+    template<class ITERATOR_TYPE>
+    CYWhenEachCursor(ITERATOR_TYPE begin, ITERATOR_TYPE end)
+        : m_ptrQueue(MakeUnique<CYCompletionQueue<TYPE>>(begin, end))
+    {
+    }
+
+    CYWhenEachCursor(CYWhenEachCursor&& rhs) noexcept = default;
+    CYWhenEachCursor& operator=(CYWhenEachCursor&& rhs) noexcept = default;
+
+public:
+    //////////////////////////////////////////////////////////////////////////
+    class CYWhenEachAwaitable
+    {
+    public:
+        CYWhenEachAwaitable(CYCompletionQueue<TYPE>& objQueue) noexcept
+            : m_objQueue(objQueue)
+            , m_objNext(objQueue)
+        {
+        }
+
+        bool await_ready() noexcept
+        {
+            return m_objNext.await_ready();
+        }
+
+        bool await_suspend(coroutine_handle<void> handleCaller) noexcept
+        {
+            return m_objNext.await_suspend(handleCaller);
+        }
+
+        CYWhenEachResult<TYPE> await_resume() noexcept
+        {
+            const auto nIndex = m_objNext.await_resume();
+            return { nIndex, std::move(m_objQueue[nIndex]) };
+        }
+
+    private:
+        CYCompletionQueue<TYPE>& m_objQueue;
+        typename CYCompletionQueue<TYPE>::CYNextAwaitable m_objNext;
+    };
+
+    size_t Size() const noexcept
+    {
+        return m_ptrQueue->Size();
+    }
+
+    size_t Remaining() const noexcept
+    {
+        return m_ptrQueue->Remaining();
+    }
+
+    bool Done() const noexcept
+    {
+        return m_ptrQueue->Remaining() == 0;
+    }
+
+    CYWhenEachAwaitable Next()
+    {
+        IfTrueThrow(Done(), TEXT("CYWhenEachCursor::Next() - all results were already handed out."));
+        return CYWhenEachAwaitable{ *m_ptrQueue };
+    }
+
+private:
+    UniquePtr<CYCompletionQueue<TYPE>> m_ptrQueue;
+};
+
+template<class ITERATOR_TYPE>
+auto WhenEach(ITERATOR_TYPE begin, ITERATOR_TYPE end)
+{
+    using result_type = typename std::iterator_traits<ITERATOR_TYPE>::value_type;
+    using type = decltype(std::declval<result_type&>().Get());
+
+    return CYWhenEachCursor<type>(begin, end);
+}
+
+CYCOROUTINE_NAMESPACE_END
+
+#endif //__CY_COMPLETION_QUEUE_CORO_HPP__
@@ -51,6 +51,9 @@
 #include "CYCoroutine/Results/Impl/CYReturnValueStruct.hpp"
 #include "CYCoroutine/Task/CYTask.hpp"
 
+#include <cstddef>
+#include <memory>
+#include <new>
 #include <vector>
 
 CYCOROUTINE_NAMESPACE_BEGIN
@@ -169,9 +172,9 @@ struct CYNuLLResultPromise
 struct CYResultPublisher : public suspend_always
 {
     template<class promise_type>
-    void await_suspend(coroutine_handle<promise_type> handle) const noexcept
+    coroutine_handle<void> await_suspend(coroutine_handle<promise_type> handle) const noexcept
     {
-        handle.promise().CompleteProducer(handle);
+        return handle.promise().CompleteProducer(handle);
     }
 };
 
@@ -203,9 +206,9 @@ public:
         return { &m_objResultState };
     }
 
-    void CompleteProducer(coroutine_handle<void> done_handle) noexcept
+    coroutine_handle<void> CompleteProducer(coroutine_handle<void> done_handle) noexcept
     {
-        this->m_objResultState.CompleteProducer(done_handle);
+        return this->m_objResultState.CompleteProducerTransfer(done_handle);
     }
 
     CYResultPublisher final_suspend() const noexcept
@@ -245,6 +248,97 @@ struct CYRescheduledResultPromise : public CYRescheduledPromise<EXECUTOR_TYPE>,
     using CYRescheduledPromise<EXECUTOR_TYPE>::CYRescheduledPromise;
 };
 
+//////////////////////////////////////////////////////////////////////////
+// Frames of coroutines declared as (std::allocator_arg_t, ALLOC, ...) or
+// (CYExecutorTag, executor, std::allocator_arg_t, ALLOC, ...) are carved out of ALLOC.
+// A copy of the allocator and a deallocation thunk are stored right after the frame,
+// so operator delete can give the memory back without knowing the allocator type.
+template<class PROMISE_TYPE>
+struct CYAllocatorAwarePromise : public PROMISE_TYPE
+{
+    using PROMISE_TYPE::PROMISE_TYPE;
+
+    template<class ALLOCATOR_TYPE, class... ARGS_TYPES>
+    static void* operator new(size_t nSize, std::allocator_arg_t, const ALLOCATOR_TYPE& allocator, const ARGS_TYPES&...)
+    {
+        return AllocateFrame(nSize, allocator);
+    }
+
+    template<class EXECUTOR_TYPE, class ALLOCATOR_TYPE, class... ARGS_TYPES>
+    static void* operator new(size_t nSize, CYExecutorTag, const EXECUTOR_TYPE&, std::allocator_arg_t, const ALLOCATOR_TYPE& allocator, const ARGS_TYPES&...)
+    {
+        return AllocateFrame(nSize, allocator);
+    }
+
+    static void operator delete(void* pFrame, size_t nSize) noexcept
+    {
+        const auto funDeallocate = *reinterpret_cast<FuncDeallocate*>(static_cast<std::byte*>(pFrame) + ThunkOffset(nSize));
+        funDeallocate(pFrame, nSize);
+    }
+
+private:
+    struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) CYFrameBlock
+    {
+        std::byte bytes[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+    };
+
+    using FuncDeallocate = void (*)(void* pFrame, size_t nSize) noexcept;
+
+    template<class ALLOCATOR_TYPE>
+    using CYBlockAllocator = typename std::allocator_traits<ALLOCATOR_TYPE>::template rebind_alloc<CYFrameBlock>;
+
+    static constexpr size_t AlignUp(size_t nSize, size_t nAlignment) noexcept
+    {
+        return (nSize + nAlignment - 1) & ~(nAlignment - 1);
+    }
+
+    static constexpr size_t ThunkOffset(size_t nSize) noexcept
+    {
+        return AlignUp(nSize, alignof(FuncDeallocate));
+    }
+
+    template<class ALLOCATOR_TYPE>
+    static constexpr size_t AllocatorOffset(size_t nSize) noexcept
+    {
+        return AlignUp(ThunkOffset(nSize) + sizeof(FuncDeallocate), alignof(CYBlockAllocator<ALLOCATOR_TYPE>));
+    }
+
+    template<class ALLOCATOR_TYPE>
+    static constexpr size_t BlockCount(size_t nSize) noexcept
+    {
+        return AlignUp(AllocatorOffset<ALLOCATOR_TYPE>(nSize) + sizeof(CYBlockAllocator<ALLOCATOR_TYPE>), sizeof(CYFrameBlock)) / sizeof(CYFrameBlock);
+    }
+
+    template<class ALLOCATOR_TYPE>
+    static void* AllocateFrame(size_t nSize, const ALLOCATOR_TYPE& allocator)
+    {
+        using BlockAllocator = CYBlockAllocator<ALLOCATOR_TYPE>;
+        static_assert(alignof(BlockAllocator) <= alignof(CYFrameBlock), "CYAllocatorAwarePromise - <<ALLOCATOR_TYPE>> is over-aligned.");
+
+        BlockAllocator objBlockAllocator(allocator);
+        const auto nBlockCount = BlockCount<ALLOCATOR_TYPE>(nSize);
+        auto pFrame = static_cast<std::byte*>(static_cast<void*>(std::to_address(std::allocator_traits<BlockAllocator>::allocate(objBlockAllocator, nBlockCount))));
+
+        new (pFrame + AllocatorOffset<ALLOCATOR_TYPE>(nSize)) BlockAllocator(std::move(objBlockAllocator));
+        new (pFrame + ThunkOffset(nSize)) FuncDeallocate(&DeallocateFrame<ALLOCATOR_TYPE>);
+        return pFrame;
+    }
+
+    template<class ALLOCATOR_TYPE>
+    static void DeallocateFrame(void* pFrame, size_t nSize) noexcept
+    {
+        using BlockAllocator = CYBlockAllocator<ALLOCATOR_TYPE>;
+        using BlockPointer = typename std::allocator_traits<BlockAllocator>::pointer;
+
+        auto pStoredAllocator = reinterpret_cast<BlockAllocator*>(static_cast<std::byte*>(pFrame) + AllocatorOffset<ALLOCATOR_TYPE>(nSize));
+        BlockAllocator objBlockAllocator(std::move(*pStoredAllocator));
+        pStoredAllocator->~BlockAllocator();
+
+        auto pBlocks = std::pointer_traits<BlockPointer>::pointer_to(*static_cast<CYFrameBlock*>(pFrame));
+        std::allocator_traits<BlockAllocator>::deallocate(objBlockAllocator, pBlocks, BlockCount<ALLOCATOR_TYPE>(nSize));
+    }
+};
+
 CYCOROUTINE_NAMESPACE_END
 
 namespace COROUTINE_NAMESPACE_STD
@@ -308,6 +402,63 @@ namespace COROUTINE_NAMESPACE_STD
         using promise_type = CYCOROUTINE_NAMESPACE::CYLazyPromise<TYPE>;
     };
 
+    // Allocator + No CYExecutor
+    template<class ALLOCATOR_TYPE, class... ARGS>
+    struct coroutine_traits<CYCOROUTINE_NAMESPACE::CYNuLLResult, std::allocator_arg_t, ALLOCATOR_TYPE, ARGS...>
+    {
+        using promise_type = CYCOROUTINE_NAMESPACE::CYAllocatorAwarePromise<CYCOROUTINE_NAMESPACE::CYResumedNuLLResultPromise>;
+    };
+
+    template<class TYPE, class ALLOCATOR_TYPE, class... ARGS>
+    struct coroutine_traits<CYCOROUTINE_NAMESPACE::CYResult<TYPE>, std::allocator_arg_t, ALLOCATOR_TYPE, ARGS...>
+    {
+        using promise_type = CYCOROUTINE_NAMESPACE::CYAllocatorAwarePromise<CYCOROUTINE_NAMESPACE::CYResumedResultPromise<TYPE>>;
+    };
+
+    template<class TYPE, class ALLOCATOR_TYPE, class... ARGS>
+    struct coroutine_traits<CYCOROUTINE_NAMESPACE::CYLazyResult<TYPE>, std::allocator_arg_t, ALLOCATOR_TYPE, ARGS...>
+    {
+        using promise_type = CYCOROUTINE_NAMESPACE::CYAllocatorAwarePromise<CYCOROUTINE_NAMESPACE::CYLazyPromise<TYPE>>;
+    };
+
+    // Allocator + Executor + no CYResult
+    template<class EXECUTOR_TYPE, class ALLOCATOR_TYPE, class... ARGS>
+    struct coroutine_traits<CYCOROUTINE_NAMESPACE::CYNuLLResult, CYCOROUTINE_NAMESPACE::CYExecutorTag, SharePtr<EXECUTOR_TYPE>, std::allocator_arg_t, ALLOCATOR_TYPE, ARGS...>
+    {
+        using promise_type = CYCOROUTINE_NAMESPACE::CYAllocatorAwarePromise<CYCOROUTINE_NAMESPACE::CYRescheduledNuLLResultPromise<EXECUTOR_TYPE>>;
+    };
+
+    template<class EXECUTOR_TYPE, class ALLOCATOR_TYPE, class... ARGS>
+    struct coroutine_traits<CYCOROUTINE_NAMESPACE::CYNuLLResult, CYCOROUTINE_NAMESPACE::CYExecutorTag, EXECUTOR_TYPE*, std::allocator_arg_t, ALLOCATOR_TYPE, ARGS...>
+    {
+        using promise_type = CYCOROUTINE_NAMESPACE::CYAllocatorAwarePromise<CYCOROUTINE_NAMESPACE::CYRescheduledNuLLResultPromise<EXECUTOR_TYPE>>;
+    };
+
+    template<class EXECUTOR_TYPE, class ALLOCATOR_TYPE, class... ARGS>
+    struct coroutine_traits<CYCOROUTINE_NAMESPACE::CYNuLLResult, CYCOROUTINE_NAMESPACE::CYExecutorTag, EXECUTOR_TYPE&, std::allocator_arg_t, ALLOCATOR_TYPE, ARGS...>
+    {
+        using promise_type = CYCOROUTINE_NAMESPACE::CYAllocatorAwarePromise<CYCOROUTINE_NAMESPACE::CYRescheduledNuLLResultPromise<EXECUTOR_TYPE>>;
+    };
+
+    // Allocator + Executor + CYResult
+    template<class TYPE, class EXECUTOR_TYPE, class ALLOCATOR_TYPE, class... ARGS>
+    struct coroutine_traits<CYCOROUTINE_NAMESPACE::CYResult<TYPE>, CYCOROUTINE_NAMESPACE::CYExecutorTag, SharePtr<EXECUTOR_TYPE>, std::allocator_arg_t, ALLOCATOR_TYPE, ARGS...>
+    {
+        using promise_type = CYCOROUTINE_NAMESPACE::CYAllocatorAwarePromise<CYCOROUTINE_NAMESPACE::CYRescheduledResultPromise<TYPE, EXECUTOR_TYPE>>;
+    };
+
+    template<class TYPE, class EXECUTOR_TYPE, class ALLOCATOR_TYPE, class... ARGS>
+    struct coroutine_traits<CYCOROUTINE_NAMESPACE::CYResult<TYPE>, CYCOROUTINE_NAMESPACE::CYExecutorTag, EXECUTOR_TYPE*, std::allocator_arg_t, ALLOCATOR_TYPE, ARGS...>
+    {
+        using promise_type = CYCOROUTINE_NAMESPACE::CYAllocatorAwarePromise<CYCOROUTINE_NAMESPACE::CYRescheduledResultPromise<TYPE, EXECUTOR_TYPE>>;
+    };
+
+    template<class TYPE, class EXECUTOR_TYPE, class ALLOCATOR_TYPE, class... ARGS>
+    struct coroutine_traits<CYCOROUTINE_NAMESPACE::CYResult<TYPE>, CYCOROUTINE_NAMESPACE::CYExecutorTag, EXECUTOR_TYPE&, std::allocator_arg_t, ALLOCATOR_TYPE, ARGS...>
+    {
+        using promise_type = CYCOROUTINE_NAMESPACE::CYAllocatorAwarePromise<CYCOROUTINE_NAMESPACE::CYRescheduledResultPromise<TYPE, EXECUTOR_TYPE>>;
+    };
+
 }  // namespace COROUTINE_NAMESPACE_STD
 
 #endif // __CY_PROMISES_CORO_HPP__
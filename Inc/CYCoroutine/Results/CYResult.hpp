@@ -54,6 +54,9 @@
 
 CYCOROUTINE_NAMESPACE_BEGIN
 
+template<class TYPE, class EXECUTOR_TYPE, class CALLABLE_TYPE, bool WITH_RESULT>
+class CYResultContinuation;
+
 template<class TYPE>
 class CYResult
 {
@@ -62,6 +65,7 @@ class CYResult
 
     friend class CYWhenResultHelper;
     friend struct CYSharedResultHelper;
+    friend struct CYSelectHelper;
 public:
     CYResult() noexcept = default;
     CYResult(CYResult&& rhs) noexcept = default;
@@ -136,6 +140,42 @@ public:
         return CYResolveAwaitable<TYPE> {std::move(m_ptrState)};
     }
 
+    /*
+     * Continuations: callable is invoked once the result is ready, either inline on the producing
+     * thread or posted to executor. It takes the ready CYResult<TYPE> or, if it can't, the value
+     * itself (nothing for void). Then() keeps no result, so exceptions thrown by the callable or
+     * stored in a result it did not take are dropped; ThenResult() forwards them into a CYResult.
+     */
+    template<class CALLABLE_TYPE>
+    void Then(CALLABLE_TYPE&& callable)
+    {
+        IfEmptyThrow(TEXT("CYResult::Then() - result is empty."));
+        Attach<void, false>(nullptr, std::forward<CALLABLE_TYPE>(callable));
+    }
+
+    template<class EXECUTOR_TYPE, class CALLABLE_TYPE>
+    void Then(SharePtr<EXECUTOR_TYPE> ptrExecutor, CALLABLE_TYPE&& callable)
+    {
+        IfEmptyThrow(TEXT("CYResult::Then() - result is empty."));
+        IfNullExecutorThrow(ptrExecutor, "CYResult::Then() - given executor is null.");
+        Attach<EXECUTOR_TYPE, false>(std::move(ptrExecutor), std::forward<CALLABLE_TYPE>(callable));
+    }
+
+    template<class CALLABLE_TYPE>
+    auto ThenResult(CALLABLE_TYPE&& callable)
+    {
+        IfEmptyThrow(TEXT("CYResult::ThenResult() - result is empty."));
+        return Attach<void, true>(nullptr, std::forward<CALLABLE_TYPE>(callable));
+    }
+
+    template<class EXECUTOR_TYPE, class CALLABLE_TYPE>
+    auto ThenResult(SharePtr<EXECUTOR_TYPE> ptrExecutor, CALLABLE_TYPE&& callable)
+    {
+        IfEmptyThrow(TEXT("CYResult::ThenResult() - result is empty."));
+        IfNullExecutorThrow(ptrExecutor, "CYResult::ThenResult() - given executor is null.");
+        return Attach<EXECUTOR_TYPE, true>(std::move(ptrExecutor), std::forward<CALLABLE_TYPE>(callable));
+    }
+
 private:
     CYResult(const CYResult& rhs) = delete;
     CYResult& operator=(const CYResult& rhs) = delete;
@@ -147,6 +187,46 @@ private:
     {
         IfTrueThrow(static_cast<bool>(!m_ptrState), pszMessage);
     }
+
+    template<class EXECUTOR_TYPE>
+    static void IfNullExecutorThrow(const SharePtr<EXECUTOR_TYPE>& ptrExecutor, const char* pszMessage)
+    {
+        if (!static_cast<bool>(ptrExecutor))
+        {
+            throw std::invalid_argument(pszMessage);
+        }
+    }
+
+    template<class EXECUTOR_TYPE, bool WITH_RESULT, class CALLABLE_TYPE>
+    auto Attach(SharePtr<EXECUTOR_TYPE> ptrExecutor, CALLABLE_TYPE&& callable)
+    {
+        using continuation_type = CYResultContinuation<TYPE, EXECUTOR_TYPE, std::decay_t<CALLABLE_TYPE>, WITH_RESULT>;
+
+        auto pState = m_ptrState.get();
+        UniquePtr<continuation_type> ptrContinuation(new continuation_type(std::move(m_ptrState), std::move(ptrExecutor), std::forward<CALLABLE_TYPE>(callable)));
+
+        if constexpr (WITH_RESULT)
+        {
+            auto objResult = ptrContinuation->GetResult();
+            Register(*pState, std::move(ptrContinuation));
+            return objResult;
+        }
+        else
+        {
+            Register(*pState, std::move(ptrContinuation));
+        }
+    }
+
+    template<class CONTINUATION_TYPE>
+    static void Register(CYResultState<TYPE>& objState, UniquePtr<CONTINUATION_TYPE> ptrContinuation) noexcept
+    {
+        // once parked in the consumer slot the continuation belongs to the producer.
+        auto pContinuation = ptrContinuation.release();
+        if (!objState.Then(*pContinuation))
+        {
+            pContinuation->Run();
+        }
+    }
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -266,6 +346,107 @@ private:
     CYProducerResultStatePtr<TYPE> m_objProducerState;
     CYConsumerResultStatePtr<TYPE> m_objConsumerState;
 };
+
+//////////////////////////////////////////////////////////////////////////
+template<class TYPE, class EXECUTOR_TYPE, class CALLABLE_TYPE, bool WITH_RESULT>
+class CYResultContinuation final : public CYContinuationBase
+{
+    static decltype(auto) Invoke(CALLABLE_TYPE& callable, CYResult<TYPE> objResult)
+    {
+        if constexpr (std::is_invocable_v<CALLABLE_TYPE&, CYResult<TYPE>>)
+        {
+            return callable(std::move(objResult));
+        }
+        else if constexpr (std::is_void_v<TYPE>)
+        {
+            objResult.Get();
+            return callable();
+        }
+        else
+        {
+            return callable(objResult.Get());
+        }
+    }
+
+    using return_type = std::decay_t<decltype(Invoke(std::declval<CALLABLE_TYPE&>(), std::declval<CYResult<TYPE>>()))>;
+    using promise_type = std::conditional_t<WITH_RESULT, CYResultPromise<return_type>, CYNuLLResult>;
+
+public:
+    template<class FUNC_TYPE>
+    CYResultContinuation(CYConsumerResultStatePtr<TYPE>&& ptrState, SharePtr<EXECUTOR_TYPE>&& ptrExecutor, FUNC_TYPE&& callable)
+        : m_callable(std::forward<FUNC_TYPE>(callable))
+        , m_ptrExecutor(std::move(ptrExecutor))
+        , m_ptrState(std::move(ptrState))
+    {
+    }
+
+    CYResult<return_type> GetResult() requires WITH_RESULT
+    {
+        return m_objPromise.GetResult();
+    }
+
+    void Run() noexcept override
+    {
+        UniquePtr<CYResultContinuation> ptrSelf(this);
+
+        if constexpr (std::is_void_v<EXECUTOR_TYPE>)
+        {
+            ptrSelf->Execute();
+        }
+        else
+        {
+            auto ptrExecutor = m_ptrExecutor;
+
+            try
+            {
+                ptrExecutor->Post([ptrSelf = std::move(ptrSelf)]() mutable
+                    {
+                        ptrSelf->Execute();
+                    });
+            }
+            catch (...)
+            {
+                // do nothing. a dropped continuation breaks its CYResultPromise, if there is one.
+            }
+        }
+    }
+
+private:
+    void Execute() noexcept
+    {
+        CYResult<TYPE> objResult(std::move(m_ptrState));
+
+        try
+        {
+            if constexpr (!WITH_RESULT)
+            {
+                Invoke(m_callable, std::move(objResult));
+            }
+            else if constexpr (std::is_void_v<return_type>)
+            {
+                Invoke(m_callable, std::move(objResult));
+                m_objPromise.SetResult();
+            }
+            else
+            {
+                m_objPromise.SetResult(Invoke(m_callable, std::move(objResult)));
+            }
+        }
+        catch (...)
+        {
+            if constexpr (WITH_RESULT)
+            {
+                m_objPromise.SetException(std::current_exception());
+            }
+        }
+    }
+
+private:
+    promise_type m_objPromise;
+    CALLABLE_TYPE m_callable;
+    SharePtr<EXECUTOR_TYPE> m_ptrExecutor;
+    CYConsumerResultStatePtr<TYPE> m_ptrState;
+};
 CYCOROUTINE_NAMESPACE_END
 
 #endif //__CY_RESULT_CORO_HPP__
\ No newline at end of file
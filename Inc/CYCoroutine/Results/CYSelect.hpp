@@ -0,0 +1,550 @@
+/*
+ * CYCoroutine License
+ * -----------
+ *
+ * CYCoroutine is licensed under the terms of the MIT license reproduced below.
+ * This means that CYCoroutine is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+/*
+ * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ * VERSION:  1.0.0
+ * PURPOSE:  A cross-platform efficient and stable Coroutine library.
+ * CREATION: 2026.10.18
+ * LCHANGE:  2026.10.18
+ * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+ */
+
+#ifndef __CY_SELECT_CORO_HPP__
+#define __CY_SELECT_CORO_HPP__
+
+#include "CYCommon/Common/Exception/CYException.hpp"
+
+#include "CYCoroutine/CYCoroutineDefine.hpp"
+#include "CYCoroutine/Results/CYLazyResult.hpp"
+#include "CYCoroutine/Results/CYResult.hpp"
+#include "CYCoroutine/Results/CYSharedResult.hpp"
+#include "CYCoroutine/Results/Impl/CYConsumerContext.hpp"
+#include "CYCoroutine/Results/Impl/CYSharedResultState.hpp"
+#include "CYCoroutine/Threads/CYCancellation.hpp"
+#include "CYCoroutine/Timers/CYTimer.hpp"
+#include "CYCoroutine/Timers/CYTimerQueue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+//////////////////////////////////////////////////////////////////////////
+// Timer case of Select(): becomes ready nDueTime after registration, the selecting
+// coroutine is then resumed on ptrExecutor.
+struct CYCOROUTINE_API CYSelectDeadline
+{
+    CYSelectDeadline(SharePtr<CYTimerQueue> ptrTimerQueue, milliseconds nDueTime, SharePtr<CYExecutor> ptrExecutor);
+
+    SharePtr<CYTimerQueue> ptrTimerQueue;
+    milliseconds nDueTime;
+    SharePtr<CYExecutor> ptrExecutor;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Decides which case of one Select() won. A case that becomes ready while the coroutine
+// is still registering only records its index, the registering thread then doesn't suspend.
+class CYCOROUTINE_API CYSelectContext
+{
+public:
+    void SetCaller(coroutine_handle<void> handleCaller) noexcept;
+
+    // Returns the coroutine to resume if nIndex won after registration finished, null otherwise.
+    coroutine_handle<void> Claim(size_t nIndex) noexcept;
+    bool Suspend() noexcept;
+
+    bool Claimed() const noexcept;
+    size_t Winner() const noexcept;
+
+private:
+    std::atomic_size_t m_nWinner{ k_nRegistering };
+    coroutine_handle<void> m_handleCaller;
+
+    static constexpr size_t k_nRegistering = static_cast<size_t>(-1);
+    static constexpr size_t k_nWaiting = static_cast<size_t>(-2);
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Parked in the result's consumer slot, detached again with TryRewindConsumer().
+class CYCOROUTINE_API CYSelectResultCase final : public CYContinuationBase
+{
+public:
+    CYSelectResultCase(CYResultStateBase& objState) noexcept;
+
+    CYSelectResultCase(const CYSelectResultCase&) = delete;
+    CYSelectResultCase& operator=(const CYSelectResultCase&) = delete;
+
+public:
+    bool Ready() const noexcept;
+    bool Register(CYSelectContext& objContext, size_t nIndex) noexcept;
+    void Deregister() noexcept;
+
+    void Run() noexcept override;
+
+private:
+    CYResultStateBase& m_objState;
+    CYSelectContext* m_pContext = nullptr;
+    size_t m_nIndex = 0;
+    bool m_bRegistered = false;
+    std::atomic_bool m_bFired{ false };
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Pushed onto the shared result's awaiter stack with a claim gate, unlinked again with TryRemove().
+class CYCOROUTINE_API CYSelectSharedCase final : private CYSharedAwaitContext
+{
+public:
+    CYSelectSharedCase(CYSharedResultStateBase& objState) noexcept;
+
+    CYSelectSharedCase(const CYSelectSharedCase&) = delete;
+    CYSelectSharedCase& operator=(const CYSelectSharedCase&) = delete;
+
+public:
+    bool Ready() const noexcept;
+    bool Register(CYSelectContext& objContext, size_t nIndex) noexcept;
+    void Deregister() noexcept;
+
+private:
+    static bool Claim(CYSharedAwaitContext& self) noexcept;
+
+private:
+    CYSharedResultStateBase& m_objState;
+    CYSelectContext* m_pContext = nullptr;
+    size_t m_nIndex = 0;
+    bool m_bRegistered = false;
+    std::atomic_bool m_bFired{ false };
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Lives inside the timer state, so a late expiry never reaches a case that was already released.
+class CYSelectTimerCase;
+class CYCOROUTINE_API CYSelectTimerFunctor
+{
+public:
+    CYSelectTimerFunctor(CYSelectTimerCase* pCase) noexcept;
+    CYSelectTimerFunctor(CYSelectTimerFunctor&& rhs) noexcept;
+
+    void operator()() noexcept;
+
+    // Once this returns the functor won't touch the case anymore.
+    void Detach() noexcept;
+
+private:
+    std::atomic<CYSelectTimerCase*> m_pCase;
+
+    static CYSelectTimerCase* BusyConstant() noexcept;
+};
+
+class CYCOROUTINE_API CYSelectTimerCase
+{
+    friend class CYSelectTimerFunctor;
+public:
+    CYSelectTimerCase(const CYSelectDeadline& objDeadline) noexcept;
+
+    CYSelectTimerCase(const CYSelectTimerCase&) = delete;
+    CYSelectTimerCase& operator=(const CYSelectTimerCase&) = delete;
+
+public:
+    bool Ready() const noexcept;
+    bool Register(CYSelectContext& objContext, size_t nIndex);
+    void Deregister() noexcept;
+
+private:
+    coroutine_handle<void> Fire() noexcept;
+
+private:
+    CYSelectDeadline m_objDeadline;
+    CYSelectContext* m_pContext = nullptr;
+    size_t m_nIndex = 0;
+    CYSelectTimerFunctor* m_pFunctor = nullptr;
+    CYTimer m_objTimer;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Registered as a cancellation callback, a cancel resumes the selecting coroutine on the cancelling thread.
+class CYCOROUTINE_API CYSelectCancellationCase final : private CYCancellationCallback
+{
+public:
+    CYSelectCancellationCase(const CYCancellationToken& token) noexcept;
+
+    CYSelectCancellationCase(const CYSelectCancellationCase&) = delete;
+    CYSelectCancellationCase& operator=(const CYSelectCancellationCase&) = delete;
+
+public:
+    bool Ready() const noexcept;
+    bool Register(CYSelectContext& objContext, size_t nIndex) noexcept;
+    void Deregister() noexcept;
+
+private:
+    void OnCancel() noexcept override;
+
+private:
+    CYCancellationToken m_token;
+    CYSelectContext* m_pContext = nullptr;
+    size_t m_nIndex = 0;
+    bool m_bRegistered = false;
+};
+
+//////////////////////////////////////////////////////////////////////////
+struct CYSelectHelper
+{
+    template<class TYPE>
+    static CYResultStateBase& State(CYResult<TYPE>& result)
+    {
+        IfTrueThrow(!static_cast<bool>(result), TEXT("Select() - one of the CYResult objects is empty."));
+        return *result.m_ptrState;
+    }
+
+    template<class TYPE>
+    static CYSharedResultStateBase& State(CYSharedResult<TYPE>& result)
+    {
+        IfTrueThrow(!static_cast<bool>(result), TEXT("Select() - one of the CYSharedResult objects is empty."));
+        return *result.m_state;
+    }
+
+    static const CYSelectDeadline& State(const CYSelectDeadline& objDeadline) noexcept
+    {
+        return objDeadline;
+    }
+
+    static const CYCancellationToken& State(const CYCancellationToken& token) noexcept
+    {
+        return token;
+    }
+};
+
+template<class TYPE>
+struct CYSelectCaseOf;
+
+template<class TYPE>
+struct CYSelectCaseOf<CYResult<TYPE>>
+{
+    using type = CYSelectResultCase;
+};
+
+template<class TYPE>
+struct CYSelectCaseOf<CYSharedResult<TYPE>>
+{
+    using type = CYSelectSharedCase;
+};
+
+template<>
+struct CYSelectCaseOf<CYSelectDeadline>
+{
+    using type = CYSelectTimerCase;
+};
+
+template<>
+struct CYSelectCaseOf<CYCancellationToken>
+{
+    using type = CYSelectCancellationCase;
+};
+
+//////////////////////////////////////////////////////////////////////////
+template<class... CASE_TYPES>
+class CYSelectAwaitable
+{
+    using SequenceType = std::index_sequence_for<CASE_TYPES...>;
+
+public:
+    template<class... SOURCE_TYPES>
+    CYSelectAwaitable(SOURCE_TYPES&... sources) noexcept
+        : m_cases(sources...)
+    {
+    }
+
+    ~CYSelectAwaitable() noexcept
+    {
+        DeregisterAll(SequenceType{});
+    }
+
+    CYSelectAwaitable(const CYSelectAwaitable&) = delete;
+    CYSelectAwaitable& operator=(const CYSelectAwaitable&) = delete;
+
+public:
+    bool await_ready() noexcept
+    {
+        return AnyReady(SequenceType{});
+    }
+
+    bool await_suspend(coroutine_handle<void> handleCaller)
+    {
+        m_objContext.SetCaller(handleCaller);
+
+        try
+        {
+            RegisterAll(SequenceType{});
+        }
+        catch (...)
+        {
+            DeregisterAll(SequenceType{});
+            throw;
+        }
+
+        if (m_objContext.Suspend())
+        {
+            return true;
+        }
+
+        // a case won while registering, the others are detached before resuming inline.
+        DeregisterAll(SequenceType{});
+        return false;
+    }
+
+    size_t await_resume() noexcept
+    {
+        DeregisterAll(SequenceType{});
+        return m_objContext.Winner();
+    }
+
+private:
+    template<size_t... is>
+    bool AnyReady(std::index_sequence<is...>) noexcept
+    {
+        return (... || TryReady<is>());
+    }
+
+    template<size_t i>
+    bool TryReady() noexcept
+    {
+        if (!std::get<i>(m_cases).Ready())
+        {
+            return false;
+        }
+
+        m_objContext.Claim(i);
+        return true;
+    }
+
+    template<size_t... is>
+    void RegisterAll(std::index_sequence<is...>)
+    {
+        (void)(... && TryRegister<is>());
+    }
+
+    template<size_t i>
+    bool TryRegister()
+    {
+        if (m_objContext.Claimed())
+        {
+            return false;
+        }
+
+        if (std::get<i>(m_cases).Register(m_objContext, i))
+        {
+            return true;
+        }
+
+        // became ready meanwhile, the cases after it are not registered at all.
+        m_objContext.Claim(i);
+        return false;
+    }
+
+    template<size_t... is>
+    void DeregisterAll(std::index_sequence<is...>) noexcept
+    {
+        (std::get<is>(m_cases).Deregister(), ...);
+    }
+
+private:
+    CYSelectContext m_objContext;
+    std::tuple<CASE_TYPES...> m_cases;
+};
+
+/*
+ * Waits for the first of several sources: CYResult and CYSharedResult objects (taken by
+ * reference, they stay valid and can be awaited or selected again), CYSelectDeadline
+ * timers and CYCancellationToken objects. co_await yields the index of the first ready case, cases ready on arrival win
+ * in argument order. Every case is registered once, the others are detached again before
+ * the coroutine continues; the selection itself allocates nothing, a deadline costs the
+ * timer its queue creates. Result cases resume the coroutine on the completing thread.
+ */
+template<class... CASE_TYPES>
+auto Select(CASE_TYPES&&... cases)
+{
+    static_assert(sizeof...(CASE_TYPES) != 0, "Select() - at least one case is required.");
+    return CYSelectAwaitable<typename CYSelectCaseOf<std::decay_t<CASE_TYPES>>::type...>(CYSelectHelper::State(cases)...);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// A result raced against one deadline, yields the result's status or STATUS_RESULT_IDLE on timeout.
+template<class SOURCE_TYPE>
+class CYTimeoutAwaitable
+{
+public:
+    CYTimeoutAwaitable(SOURCE_TYPE& source, const CYSelectDeadline& objDeadline)
+        : m_source(source)
+        , m_objSelect(CYSelectHelper::State(source), objDeadline)
+    {
+    }
+
+    CYTimeoutAwaitable(const CYTimeoutAwaitable&) = delete;
+    CYTimeoutAwaitable& operator=(const CYTimeoutAwaitable&) = delete;
+
+public:
+    bool await_ready() noexcept
+    {
+        return m_objSelect.await_ready();
+    }
+
+    bool await_suspend(coroutine_handle<void> handleCaller)
+    {
+        return m_objSelect.await_suspend(handleCaller);
+    }
+
+    EResultStatus await_resume()
+    {
+        return m_objSelect.await_resume() == 0 ? m_source.Status() : EResultStatus::STATUS_RESULT_IDLE;
+    }
+
+private:
+    SOURCE_TYPE& m_source;
+    CYSelectAwaitable<typename CYSelectCaseOf<SOURCE_TYPE>::type, CYSelectTimerCase> m_objSelect;
+};
+
+/*
+ * Waits at most nTimeout for result, like WaitFor() but suspending: co_await yields
+ * STATUS_RESULT_IDLE if the deadline came first, the same status WaitFor() reports on a
+ * timeout, as the result is still pending then and can be awaited again. The wait costs the one timer it queues on ptrTimerQueue, which is taken
+ * out of the queue again as soon as the result wins. Resumes on the completing thread, or
+ * on ptrExecutor when timing out.
+ */
+template<class TYPE>
+CYTimeoutAwaitable<CYResult<TYPE>> WithTimeout(CYResult<TYPE>& result, milliseconds nTimeout, SharePtr<CYTimerQueue> ptrTimerQueue, SharePtr<CYExecutor> ptrExecutor)
+{
+    return CYTimeoutAwaitable<CYResult<TYPE>>(result, CYSelectDeadline(std::move(ptrTimerQueue), nTimeout, std::move(ptrExecutor)));
+}
+
+template<class TYPE>
+CYTimeoutAwaitable<CYSharedResult<TYPE>> WithTimeout(CYSharedResult<TYPE>& result, milliseconds nTimeout, SharePtr<CYTimerQueue> ptrTimerQueue, SharePtr<CYExecutor> ptrExecutor)
+{
+    return CYTimeoutAwaitable<CYSharedResult<TYPE>>(result, CYSelectDeadline(std::move(ptrTimerQueue), nTimeout, std::move(ptrExecutor)));
+}
+
+// Runs the lazy task and fails with std::errc::timed_out if it isn't done within nTimeout. The task
+// is only abandoned, not stopped: it keeps running and whatever it produces later is dropped. Waits
+// on primitives that take a CYCancellationToken are bounded with the factory overload below instead.
+template<class TYPE>
+CYLazyResult<TYPE> WithTimeout(CYLazyResult<TYPE> lazy, milliseconds nTimeout, SharePtr<CYTimerQueue> ptrTimerQueue, SharePtr<CYExecutor> ptrExecutor)
+{
+    auto result = lazy.Run();
+
+    const auto eStatus = co_await WithTimeout(result, nTimeout, std::move(ptrTimerQueue), std::move(ptrExecutor));
+    if (eStatus == EResultStatus::STATUS_RESULT_IDLE)
+    {
+        throw std::system_error(std::make_error_code(std::errc::timed_out), "WithTimeout() - operation timed out.");
+    }
+
+    co_return co_await result;
+}
+
+template<class LAZY_TYPE, class FACTORY_TYPE>
+LAZY_TYPE WithTimeoutImpl(milliseconds nTimeout, SharePtr<CYTimerQueue> ptrTimerQueue, SharePtr<CYExecutor> ptrExecutor, FACTORY_TYPE factory)
+{
+    CYCancellationSource objSource;
+    const auto objTimer = ptrTimerQueue->MakeOneShotTimer(nTimeout, std::move(ptrExecutor), [objSource]() mutable
+        {
+            objSource.Cancel();
+        });
+
+    auto lazy = factory(objSource.Token());
+
+    try
+    {
+        co_return co_await lazy;
+    }
+    catch (const std::system_error& e)
+    {
+        if (e.code() != std::errc::operation_canceled || !objSource.IsCancelled())
+        {
+            throw;
+        }
+    }
+
+    throw std::system_error(std::make_error_code(std::errc::timed_out), "WithTimeout() - operation timed out.");
+}
+
+/*
+ * Bounds a cancellable wait: factory(token) builds the lazy wait, e.g.
+ * [&](CYCancellationToken token) { return objLock.Lock(executor, token); }, and the token is
+ * cancelled once nTimeout expires. The primitive then takes the waiter out of its queue, so
+ * nothing is left running after a timeout, which fails with std::errc::timed_out rather than
+ * yielding STATUS_RESULT_IDLE, since there is no pending result to come back to. Covers
+ * CAsyncLock::Lock(), CYAsyncCondition::await(), MakeDelayObject() and Submit(); the awaiters
+ * of CYAsyncEvent, CYAsyncLatch, CYAsyncSemaphore and CYAsyncSharedLock take no token and
+ * can't be bounded this way.
+ */
+template<class FACTORY_TYPE>
+auto WithTimeout(milliseconds nTimeout, SharePtr<CYTimerQueue> ptrTimerQueue, SharePtr<CYExecutor> ptrExecutor, FACTORY_TYPE factory)
+{
+    using lazy_type = std::invoke_result_t<FACTORY_TYPE&, CYCancellationToken>;
+
+    if (!static_cast<bool>(ptrTimerQueue))
+    {
+        throw std::invalid_argument("WithTimeout() - timer queue is null.");
+    }
+
+    if (!static_cast<bool>(ptrExecutor))
+    {
+        throw std::invalid_argument("WithTimeout() - executor is null.");
+    }
+
+    return WithTimeoutImpl<lazy_type>(nTimeout, std::move(ptrTimerQueue), std::move(ptrExecutor), std::move(factory));
+}
+
+/*
+ * Awaits result unless token gets cancelled first, a cancel detaches the wait right away and
+ * fails with operation_canceled while result is left pending. Resumes on the thread that
+ * completed the result or cancelled the token.
+ */
+template<class TYPE>
+CYLazyResult<TYPE> WithCancellation(CYResult<TYPE> result, CYCancellationToken token)
+{
+    const auto nWinner = co_await Select(result, token);
+    if (nWinner != 0)
+    {
+        token.ThrowIfCancelled();
+    }
+
+    co_return co_await result;
+}
+
+CYCOROUTINE_NAMESPACE_END
+
+#endif //__CY_SELECT_CORO_HPP__
@@ -51,6 +51,7 @@ CYCOROUTINE_NAMESPACE_BEGIN
 template<class TYPE>
 class CYSharedResult
 {
+    friend struct CYSelectHelper;
 public:
     CYSharedResult() noexcept = default;
     virtual ~CYSharedResult() noexcept = default;
@@ -76,6 +77,31 @@ public:
         m_state->Share(std::static_pointer_cast<CYSharedResultStateBase>(m_state));
     }
 
+    // Awaiting coroutines are resumed on ptrResumeExecutor in batches of nBatchSize once the result is ready.
+    template<class EXECUTOR_TYPE>
+    CYSharedResult(CYResult<TYPE> rhs, SharePtr<EXECUTOR_TYPE> ptrResumeExecutor, size_t nBatchSize = 32)
+    {
+        if (!static_cast<bool>(ptrResumeExecutor))
+        {
+            throw std::invalid_argument("CYSharedResult - given resume executor is null.");
+        }
+
+        if (nBatchSize == 0)
+        {
+            throw std::invalid_argument("CYSharedResult - batch size must be positive.");
+        }
+
+        if (!static_cast<bool>(rhs))
+        {
+            return;
+        }
+
+        auto CYResultState = CYSharedResultHelper::GetState(rhs);
+        m_state = MakeShared<CYSharedResultState<TYPE>>(std::move(CYResultState));
+        m_state->SetResumeExecutor(std::move(ptrResumeExecutor), nBatchSize);
+        m_state->Share(std::static_pointer_cast<CYSharedResultStateBase>(m_state));
+    }
+
     CYSharedResult& operator=(const CYSharedResult& rhs) noexcept
     {
         if (this != &rhs && m_state != rhs.m_state)
@@ -0,0 +1,261 @@
+/*
+ * CYCoroutine License
+ * -----------
+ *
+ * CYCoroutine is licensed under the terms of the MIT license reproduced below.
+ * This means that CYCoroutine is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+/*
+ * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ * VERSION:  1.0.0
+ * PURPOSE:  A cross-platform efficient and stable Coroutine library.
+ * CREATION: 2026.10.18
+ * LCHANGE:  2026.10.18
+ * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+ */
+
+#ifndef __CY_TASK_GROUP_CORO_HPP__
+#define __CY_TASK_GROUP_CORO_HPP__
+
+#include "CYCoroutine/CYCoroutineDefine.hpp"
+#include "CYCoroutine/Executors/CYExecutor.hpp"
+#include "CYCoroutine/Results/CYLazyResult.hpp"
+#include "CYCoroutine/Results/CYPromises.hpp"
+#include "CYCoroutine/Results/CYResult.hpp"
+#include "CYCoroutine/Results/CYSharedResult.hpp"
+#include "CYCoroutine/Results/Impl/CYConsumerContext.hpp"
+#include "CYCoroutine/Threads/CYCancellation.hpp"
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <type_traits>
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+// What a failing child does to its siblings.
+enum class ETaskGroupPolicy
+{
+    // nothing, Join() still waits for all children and rethrows the first failure.
+    POLICY_WAIT_ALL,
+    // cancels the group's token: children not started yet are skipped, running ones can observe it.
+    POLICY_CANCEL_ON_FAILURE
+};
+
+class CYTaskGroup;
+class CYTaskGroupPromise;
+
+struct CYCOROUTINE_API CYTaskGroupChild
+{
+    coroutine_handle<CYTaskGroupPromise> handle;
+};
+
+// Children returning one of these are awaited, everything else counts as done once the callable returns.
+template<class TYPE>
+struct CYIsTaskGroupAwaited : std::false_type {};
+
+template<class TYPE>
+struct CYIsTaskGroupAwaited<CYResult<TYPE>> : std::true_type {};
+
+template<class TYPE>
+struct CYIsTaskGroupAwaited<CYLazyResult<TYPE>> : std::true_type {};
+
+template<class TYPE>
+struct CYIsTaskGroupAwaited<CYSharedResult<TYPE>> : std::true_type {};
+
+//////////////////////////////////////////////////////////////////////////
+// Frame of one spawned child. It is destroyed before the child counts down, so once
+// Join() returns no child touches its frame, its captures or its allocator anymore.
+class CYCOROUTINE_API CYTaskGroupPromise
+{
+public:
+    class CYStartAwaiter : public suspend_always
+    {
+    public:
+        CYStartAwaiter(CYTaskGroupPromise& promise) noexcept;
+        void await_resume() const;
+
+    private:
+        CYTaskGroupPromise& m_promise;
+    };
+
+    class CYFinalAwaiter : public suspend_always
+    {
+    public:
+        CYFinalAwaiter(CYTaskGroup& group) noexcept;
+        void await_suspend(coroutine_handle<void> handle) const noexcept;
+
+    private:
+        CYTaskGroup& m_group;
+    };
+
+public:
+    CYTaskGroupChild    get_return_object() noexcept;
+    CYStartAwaiter      initial_suspend() noexcept;
+    CYFinalAwaiter      final_suspend() const noexcept;
+    void                unhandled_exception() noexcept;
+    void                return_void() const noexcept;
+
+    void                Start(CYTaskGroup& group, CYExecutor& executor) noexcept;
+
+private:
+    CYTaskGroup*        m_pGroup = nullptr;
+    bool                m_bInterrupted = false;
+};
+
+//////////////////////////////////////////////////////////////////////////
+class CYCOROUTINE_API CYTaskGroupJoinAwaiter
+{
+    friend class CYTaskGroup;
+public:
+    CYTaskGroupJoinAwaiter(CYTaskGroup& parent, SharePtr<CYExecutor> ptrResumeExecutor) noexcept;
+
+    bool            await_ready() const noexcept;
+    bool            await_suspend(coroutine_handle<void> hHandle) noexcept;
+    void            await_resume();
+
+private:
+    CYTaskGroup&            m_parent;
+    SharePtr<CYExecutor>    m_ptrResumeExecutor;
+    coroutine_handle<void>  m_handleResume;
+    bool                    m_bInterrupted = false;
+};
+
+//////////////////////////////////////////////////////////////////////////
+/*
+ * Scope for child coroutines: Spawn() starts a child on an executor and keeps no result
+ * object for it, co_await Join(executor) resumes once every child (including the ones
+ * spawned by children meanwhile) has finished and rethrows the first failure. The children
+ * are tracked by one atomic counter, the last one to finish resumes the joining coroutine.
+ * Spawn(std::allocator_arg, allocator, ...) carves the child frame out of allocator, with
+ * Join() as the point after which a request-scoped arena can be released. The group must
+ * not be destroyed while children are running; after Join() it can be reused.
+ */
+class CYCOROUTINE_API CYTaskGroup
+{
+    friend class CYTaskGroupPromise;
+    friend class CYTaskGroupJoinAwaiter;
+public:
+    explicit CYTaskGroup(ETaskGroupPolicy ePolicy = ETaskGroupPolicy::POLICY_CANCEL_ON_FAILURE);
+    ~CYTaskGroup() noexcept;
+
+    CYTaskGroup(const CYTaskGroup&) = delete;
+    CYTaskGroup& operator=(const CYTaskGroup&) = delete;
+
+public:
+    template<class EXECUTOR_TYPE, class CALLABLE_TYPE, class... ARGS_TYPES>
+    void Spawn(SharePtr<EXECUTOR_TYPE> ptrExecutor, CALLABLE_TYPE&& callable, ARGS_TYPES&&... args)
+    {
+        static_assert(std::is_invocable_v<CALLABLE_TYPE, ARGS_TYPES...>, "CYTaskGroup::Spawn() - <<CALLABLE_TYPE>> is not invokable with <<ARGS_TYPES...>>");
+
+        VerifyExecutor(ptrExecutor.get());
+        Launch(*ptrExecutor, ChildBridge<std::decay_t<CALLABLE_TYPE>, std::decay_t<ARGS_TYPES>...>(std::forward<CALLABLE_TYPE>(callable), std::forward<ARGS_TYPES>(args)...));
+    }
+
+    template<class ALLOCATOR_TYPE, class EXECUTOR_TYPE, class CALLABLE_TYPE, class... ARGS_TYPES>
+    void Spawn(std::allocator_arg_t, const ALLOCATOR_TYPE& allocator, SharePtr<EXECUTOR_TYPE> ptrExecutor, CALLABLE_TYPE&& callable, ARGS_TYPES&&... args)
+    {
+        static_assert(std::is_invocable_v<CALLABLE_TYPE, ARGS_TYPES...>, "CYTaskGroup::Spawn() - <<CALLABLE_TYPE>> is not invokable with <<ARGS_TYPES...>>");
+
+        VerifyExecutor(ptrExecutor.get());
+        Launch(*ptrExecutor, ChildBridge<ALLOCATOR_TYPE, std::decay_t<CALLABLE_TYPE>, std::decay_t<ARGS_TYPES>...>(std::allocator_arg, allocator, std::forward<CALLABLE_TYPE>(callable), std::forward<ARGS_TYPES>(args)...));
+    }
+
+    CYTaskGroupJoinAwaiter  Join(SharePtr<CYExecutor> ptrResumeExecutor);
+
+    // cancelled on the first failure (POLICY_CANCEL_ON_FAILURE) or by Cancel(), for the children to observe.
+    CYCancellationToken     Token() const noexcept;
+    void                    Cancel() noexcept;
+
+    ETaskGroupPolicy        Policy() const noexcept;
+
+private:
+    template<class CALLABLE_TYPE, class... ARGS_TYPES>
+    static CYTaskGroupChild ChildBridge(CALLABLE_TYPE callable, ARGS_TYPES... args)
+    {
+        co_await ChildBody(callable, args...);
+    }
+
+    template<class ALLOCATOR_TYPE, class CALLABLE_TYPE, class... ARGS_TYPES>
+    static CYTaskGroupChild ChildBridge(std::allocator_arg_t, ALLOCATOR_TYPE, CALLABLE_TYPE callable, ARGS_TYPES... args)
+    {
+        co_await ChildBody(callable, args...);
+    }
+
+    template<class CALLABLE_TYPE, class... ARGS_TYPES>
+    static auto ChildBody(CALLABLE_TYPE& callable, ARGS_TYPES&... args)
+    {
+        using RETURN_TYPE = std::invoke_result_t<CALLABLE_TYPE&, ARGS_TYPES&...>;
+        if constexpr (CYIsTaskGroupAwaited<RETURN_TYPE>::value)
+        {
+            return callable(args...);
+        }
+        else
+        {
+            callable(args...);
+            return suspend_never{};
+        }
+    }
+
+    static void VerifyExecutor(const CYExecutor* pExecutor);
+
+    void Launch(CYExecutor& executor, CYTaskGroupChild objChild) noexcept;
+    void Fail(std::exception_ptr pException) noexcept;
+    void Arrive() noexcept;
+
+private:
+    const ETaskGroupPolicy              m_ePolicy;
+    CYCancellationSource                m_objSource;
+
+    // running children + 1, the extra count is the group's own and is dropped by Join().
+    std::atomic_size_t                  m_nPending{ 1 };
+    CYTaskGroupJoinAwaiter*             m_pJoiner = nullptr;
+
+    std::atomic_bool                    m_bFailed{ false };
+    std::exception_ptr                  m_pException;
+};
+
+CYCOROUTINE_NAMESPACE_END
+
+namespace COROUTINE_NAMESPACE_STD
+{
+    template<class... ARGS>
+    struct coroutine_traits<CYCOROUTINE_NAMESPACE::CYTaskGroupChild, ARGS...>
+    {
+        using promise_type = CYCOROUTINE_NAMESPACE::CYTaskGroupPromise;
+    };
+
+    template<class ALLOCATOR_TYPE, class... ARGS>
+    struct coroutine_traits<CYCOROUTINE_NAMESPACE::CYTaskGroupChild, std::allocator_arg_t, ALLOCATOR_TYPE, ARGS...>
+    {
+        using promise_type = CYCOROUTINE_NAMESPACE::CYAllocatorAwarePromise<CYCOROUTINE_NAMESPACE::CYTaskGroupPromise>;
+    };
+}  // namespace COROUTINE_NAMESPACE_STD
+
+#endif //__CY_TASK_GROUP_CORO_HPP__
@@ -49,7 +49,10 @@
 #include "CYCoroutine/Results/CYLazyResult.hpp"
 #include "CYCoroutine/Results/CYResumeOn.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <stdexcept>
 #include <tuple>
 #include <vector>
 
@@ -126,6 +129,50 @@ public:
         CYResultStateBase& m_objState;
     };
 
+    //////////////////////////////////////////////////////////////////////////
+    // Waits for a whole collection with one shared countdown instead of one await per result.
+    template<class RESULT_TYPES>
+    class CYWhenALLCountdownAwaitable
+    {
+    public:
+        CYWhenALLCountdownAwaitable(RESULT_TYPES& results) noexcept
+            : m_results(results)
+            , m_objCountdown(CYWhenResultHelper::Size(results))
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return CYWhenResultHelper::Size(m_results) == 0;
+        }
+
+        bool await_suspend(coroutine_handle<void> handleCoro) noexcept
+        {
+            m_objCountdown.SetCaller(handleCoro);
+
+            size_t nDone = 0;
+            const auto nRangeLength = CYWhenResultHelper::Size(m_results);
+            for (size_t i = 0; i < nRangeLength; i++)
+            {
+                auto& objState = CYWhenResultHelper::At(m_results, i);
+                if (!objState.WhenALL(m_objCountdown))
+                {
+                    ++nDone;
+                }
+            }
+
+            return m_objCountdown.Suspend(nDone);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+
+    private:
+        RESULT_TYPES& m_results;
+        CYCountdownContext m_objCountdown;
+    };
+
     //////////////////////////////////////////////////////////////////////////
     template<class RESULT_TYPES>
     class CYWhenAnyAwaitable
@@ -218,6 +265,33 @@ private:
     }
 };
 
+//////////////////////////////////////////////////////////////////////////
+// Thrown by WhenALLValues() when results failed, carries every failure with its index in the range.
+class CYAggregateException : public std::runtime_error
+{
+public:
+    CYAggregateException(std::vector<size_t> lstIndices, std::vector<std::exception_ptr> lstExceptions)
+        : std::runtime_error("WhenALLValues() - one or more results completed with an exception.")
+        , m_lstIndices(std::move(lstIndices))
+        , m_lstExceptions(std::move(lstExceptions))
+    {
+    }
+
+    const std::vector<size_t>& Indices() const noexcept
+    {
+        return m_lstIndices;
+    }
+
+    const std::vector<std::exception_ptr>& Exceptions() const noexcept
+    {
+        return m_lstExceptions;
+    }
+
+private:
+    std::vector<size_t> m_lstIndices;
+    std::vector<std::exception_ptr> m_lstExceptions;
+};
+
 //////////////////////////////////////////////////////////////////////////
 template<class SEQUENCE_TYPE>
 struct CYWhenAnyResult
@@ -299,6 +373,59 @@ CYLazyResult<std::vector<typename std::iterator_traits<ITERATOR_TYPE>::value_typ
     return WhenALLImpl(resume_executor, std::vector<type> {std::make_move_iterator(begin), std::make_move_iterator(end)});
 }
 
+template<class EXECUTOR_TYPE, class TYPE>
+CYLazyResult<std::vector<TYPE>> WhenALLValuesImpl(SharePtr<EXECUTOR_TYPE> resume_executor, std::vector<CYResult<TYPE>> results)
+{
+    co_await CYWhenResultHelper::CYWhenALLCountdownAwaitable<std::vector<CYResult<TYPE>>> {results};
+    co_await ResumeOn(resume_executor);
+
+    std::vector<TYPE> values;
+    values.reserve(results.size());
+
+    std::vector<size_t> lstFailed;
+    std::vector<std::exception_ptr> lstExceptions;
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        try
+        {
+            values.emplace_back(results[i].Get());
+        }
+        catch (...)
+        {
+            lstFailed.emplace_back(i);
+            lstExceptions.emplace_back(std::current_exception());
+        }
+    }
+
+    if (!lstExceptions.empty())
+    {
+        throw CYAggregateException(std::move(lstFailed), std::move(lstExceptions));
+    }
+
+    co_return std::move(values);
+}
+
+// Like WhenALL() over a range, but yields the plain values, aggregates the failures into one
+// CYAggregateException and waits on a single shared countdown, so the caller is resumed once
+// rather than once per pending result. It is a convenience, not a faster WhenALL(): registering
+// every result up front is an extra pass over them, see the "whenall" section of the benchmark.
+template<class EXECUTOR_TYPE, class ITERATOR_TYPE>
+auto WhenALLValues(SharePtr<EXECUTOR_TYPE> resume_executor, ITERATOR_TYPE begin, ITERATOR_TYPE end)
+{
+    CYWhenResultHelper::IfEmptyThrowRange("WhenALLValues() - one of the CYResult objects is empty.", begin, end);
+
+    if (!static_cast<bool>(resume_executor))
+    {
+        throw std::invalid_argument("WhenALLValues() - given resume_executor is null.");
+    }
+
+    using result_type = typename std::iterator_traits<ITERATOR_TYPE>::value_type;
+    using type = decltype(std::declval<result_type&>().Get());
+    static_assert(!std::is_void_v<type>, "WhenALLValues() - CYResult<void> has no values to collect, use WhenALL().");
+
+    return WhenALLValuesImpl<EXECUTOR_TYPE, type>(resume_executor, std::vector<result_type> {std::make_move_iterator(begin), std::make_move_iterator(end)});
+}
+
 template<class EXECUTOR_TYPE, class TUPLE_TYPE>
 CYLazyResult<CYWhenAnyResult<TUPLE_TYPE>> WhenAnyImpl(SharePtr<EXECUTOR_TYPE> resume_executor, TUPLE_TYPE tuple)
 {
@@ -348,6 +475,102 @@ CYLazyResult<CYWhenAnyResult<std::vector<typename std::iterator_traits<ITERATOR_
     using type = typename std::iterator_traits<ITERATOR_TYPE>::value_type;
     return WhenAnyImpl(resume_executor, std::vector<type> {std::make_move_iterator(begin), std::make_move_iterator(end)});
 }
+
+//////////////////////////////////////////////////////////////////////////
+template<class TYPE>
+struct CYIsLazyResult : std::false_type
+{
+};
+
+template<class TYPE>
+struct CYIsLazyResult<CYLazyResult<TYPE>> : std::true_type
+{
+};
+
+template<class EXECUTOR_TYPE, class TYPE>
+CYResult<TYPE> WhenALLBoundedRun(CYExecutorTag, SharePtr<EXECUTOR_TYPE> executor, CYLazyResult<TYPE> lazy)
+{
+    co_return co_await lazy;
+}
+
+template<class EXECUTOR_TYPE, class ITEM_TYPE>
+auto WhenALLBoundedStart(const SharePtr<EXECUTOR_TYPE>& executor, ITEM_TYPE&& item)
+{
+    if constexpr (CYIsLazyResult<std::decay_t<ITEM_TYPE>>::value)
+    {
+        return WhenALLBoundedRun(CYExecutorTag{}, executor, std::move(item));
+    }
+    else
+    {
+        return executor->Submit(std::forward<ITEM_TYPE>(item));
+    }
+}
+
+// one lane keeps one item in flight: it claims the next index as soon as its current item finished.
+template<class EXECUTOR_TYPE, class ITEM_TYPE, class RESULT_TYPE>
+CYResult<void> WhenALLBoundedLane(SharePtr<EXECUTOR_TYPE> executor, std::vector<ITEM_TYPE>& items, std::vector<RESULT_TYPE>& results, std::atomic_size_t& nNext)
+{
+    for (auto i = nNext.fetch_add(1, std::memory_order_relaxed); i < items.size(); i = nNext.fetch_add(1, std::memory_order_relaxed))
+    {
+        results[i] = WhenALLBoundedStart(executor, std::move(items[i]));
+        co_await CYWhenResultHelper::CYWhenALLAwaitable{ CYWhenResultHelper::At(results, i) };
+    }
+}
+
+template<class EXECUTOR_TYPE, class ITEM_TYPE, class RESULT_TYPE>
+CYLazyResult<std::vector<RESULT_TYPE>> WhenALLBoundedImpl(SharePtr<EXECUTOR_TYPE> executor, size_t nMaxInFlight, std::vector<ITEM_TYPE> items)
+{
+    std::vector<RESULT_TYPE> results(items.size());
+    std::atomic_size_t nNext{ 0 };
+
+    std::vector<CYResult<void>> lanes;
+    const auto nLanes = std::min(nMaxInFlight, items.size());
+    lanes.reserve(nLanes);
+    for (size_t i = 0; i < nLanes; i++)
+    {
+        lanes.emplace_back(WhenALLBoundedLane(executor, items, results, nNext));
+    }
+
+    // the lanes reference items, results and nNext in this frame: every lane has to finish before
+    // a failure of one of them may propagate.
+    co_await CYWhenResultHelper::CYWhenALLCountdownAwaitable<std::vector<CYResult<void>>>{ lanes };
+    for (auto& lane : lanes)
+    {
+        lane.Get();
+    }
+
+    co_await ResumeOn(executor);
+    co_return std::move(results);
+}
+
+/*
+ * Runs a range of CYLazyResult<T> or callables on executor with at most nMaxInFlight of them
+ * running at any time, starting the next one as soon as one finishes. Yields the CYResult of
+ * every item in range order once all of them completed.
+ */
+template<class EXECUTOR_TYPE, class ITERATOR_TYPE>
+auto WhenALLBounded(SharePtr<EXECUTOR_TYPE> executor, size_t nMaxInFlight, ITERATOR_TYPE begin, ITERATOR_TYPE end)
+{
+    if (!static_cast<bool>(executor))
+    {
+        throw std::invalid_argument("WhenALLBounded() - given executor is null.");
+    }
+
+    if (nMaxInFlight == 0)
+    {
+        throw std::invalid_argument("WhenALLBounded() - nMaxInFlight must be positive.");
+    }
+
+    using item_type = typename std::iterator_traits<ITERATOR_TYPE>::value_type;
+    using result_type = decltype(WhenALLBoundedStart(executor, std::declval<item_type>()));
+
+    if constexpr (CYIsLazyResult<item_type>::value)
+    {
+        CYWhenResultHelper::IfEmptyThrowRange("WhenALLBounded() - one of the CYLazyResult objects is empty.", begin, end);
+    }
+
+    return WhenALLBoundedImpl<EXECUTOR_TYPE, item_type, result_type>(executor, nMaxInFlight, std::vector<item_type> {std::make_move_iterator(begin), std::make_move_iterator(end)});
+}
 CYCOROUTINE_NAMESPACE_END
 
 #endif // __CY_WHEN_RESULT_CORO_HPP__
@@ -0,0 +1,248 @@
+/*
+ * CYCoroutine License
+ * -----------
+ *
+ * CYCoroutine is licensed under the terms of the MIT license reproduced below.
+ * This means that CYCoroutine is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+/*
+ * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ * VERSION:  1.0.0
+ * PURPOSE:  A cross-platform efficient and stable Coroutine library.
+ * CREATION: 2026.10.18
+ * LCHANGE:  2026.10.18
+ * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+ */
+
+#ifndef __CY_ASYNC_GENERATOR_STATE_CORO_HPP__
+#define __CY_ASYNC_GENERATOR_STATE_CORO_HPP__
+
+#include "CYCoroutine/CYCoroutineDefine.hpp"
+
+#include <cassert>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+template<typename TYPE>
+class CYAsyncGenerator;
+
+/*
+ * The producer and the consumer hand control to each other by symmetric transfer: Next()/++ jumps
+ * into the producer, co_yield and the final suspend jump back into the consumer. If the producer
+ * co_awaits something that suspends, the consumer is resumed later on whatever thread resumes
+ * the producer, no executor is involved.
+ */
+template<typename TYPE>
+class CYAsyncGeneratorState
+{
+public:
+    using value_type = std::remove_reference_t<TYPE>;
+
+public:
+    //////////////////////////////////////////////////////////////////////////
+    struct CYTransferAwaiter : public suspend_always
+    {
+        coroutine_handle<void> await_suspend(coroutine_handle<CYAsyncGeneratorState> handle) const noexcept
+        {
+            auto handleConsumer = std::exchange(handle.promise().m_handleConsumer, {});
+            assert(static_cast<bool>(handleConsumer));
+            return handleConsumer;
+        }
+    };
+
+public:
+    CYAsyncGenerator<TYPE> get_return_object() noexcept
+    {
+        return CYAsyncGenerator<TYPE> {coroutine_handle<CYAsyncGeneratorState<TYPE>>::from_promise(*this)};
+    }
+
+    suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    CYTransferAwaiter final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    // the yielded object outlives the suspension, the consumer gets a reference to it.
+    CYTransferAwaiter yield_value(value_type& ref) noexcept
+    {
+        m_pValue = std::addressof(ref);
+        return {};
+    }
+
+    CYTransferAwaiter yield_value(value_type&& ref) noexcept
+    {
+        m_pValue = std::addressof(ref);
+        return {};
+    }
+
+    void unhandled_exception() noexcept
+    {
+        m_pException = std::current_exception();
+    }
+
+    void return_void() const noexcept
+    {
+    }
+
+    value_type& value() const noexcept
+    {
+        assert(m_pValue != nullptr);
+        return *m_pValue;
+    }
+
+    void throw_if_exception() const
+    {
+        if (static_cast<bool>(m_pException))
+        {
+            std::rethrow_exception(m_pException);
+        }
+    }
+
+    void SetConsumer(coroutine_handle<void> handleConsumer) noexcept
+    {
+        assert(!static_cast<bool>(m_handleConsumer));
+        m_handleConsumer = handleConsumer;
+    }
+
+private:
+    value_type* m_pValue = nullptr;
+    std::exception_ptr m_pException;
+    coroutine_handle<void> m_handleConsumer;
+};
+
+//////////////////////////////////////////////////////////////////////////
+struct CYAsyncGeneratorEndIterator
+{
+};
+
+//////////////////////////////////////////////////////////////////////////
+template<typename TYPE>
+class CYAsyncGeneratorIterator
+{
+public:
+    using value_type = std::remove_reference_t<TYPE>;
+    using reference = value_type&;
+    using pointer = value_type*;
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+
+public:
+    CYAsyncGeneratorIterator(coroutine_handle<CYAsyncGeneratorState<TYPE>> handle) noexcept
+        : m_handleCoro(handle)
+    {
+        assert(static_cast<bool>(m_handleCoro));
+    }
+
+    // co_await ++it;
+    auto operator++() noexcept
+    {
+        assert(static_cast<bool>(m_handleCoro));
+        assert(!m_handleCoro.done());
+        return CYAdvanceAwaitable{ *this };
+    }
+
+    reference operator*() const noexcept
+    {
+        assert(static_cast<bool>(m_handleCoro));
+        return m_handleCoro.promise().value();
+    }
+
+    pointer operator->() const noexcept
+    {
+        assert(static_cast<bool>(m_handleCoro));
+        return std::addressof(operator*());
+    }
+
+    friend bool operator==(const CYAsyncGeneratorIterator& it0, const CYAsyncGeneratorIterator& it1) noexcept
+    {
+        return it0.m_handleCoro == it1.m_handleCoro;
+    }
+
+    friend bool operator==(const CYAsyncGeneratorIterator& it, CYAsyncGeneratorEndIterator) noexcept
+    {
+        return it.m_handleCoro.done();
+    }
+
+    friend bool operator==(CYAsyncGeneratorEndIterator end_it, const CYAsyncGeneratorIterator& it) noexcept
+    {
+        return (it == end_it);
+    }
+
+    friend bool operator!=(const CYAsyncGeneratorIterator& it, CYAsyncGeneratorEndIterator end_it) noexcept
+    {
+        return !(it == end_it);
+    }
+
+    friend bool operator!=(CYAsyncGeneratorEndIterator end_it, const CYAsyncGeneratorIterator& it) noexcept
+    {
+        return it != end_it;
+    }
+
+private:
+    struct CYAdvanceAwaitable
+    {
+        CYAsyncGeneratorIterator& m_it;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        coroutine_handle<void> await_suspend(coroutine_handle<void> handleConsumer) noexcept
+        {
+            m_it.m_handleCoro.promise().SetConsumer(handleConsumer);
+            return m_it.m_handleCoro;
+        }
+
+        CYAsyncGeneratorIterator& await_resume() const
+        {
+            if (m_it.m_handleCoro.done())
+            {
+                m_it.m_handleCoro.promise().throw_if_exception();
+            }
+
+            return m_it;
+        }
+    };
+
+private:
+    coroutine_handle<CYAsyncGeneratorState<TYPE>> m_handleCoro;
+};
+
+CYCOROUTINE_NAMESPACE_END
+
+#endif //__CY_ASYNC_GENERATOR_STATE_CORO_HPP__
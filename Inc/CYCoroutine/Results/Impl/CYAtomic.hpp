@@ -47,9 +47,29 @@
 
 #include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cstring>
 #include <type_traits>
 #include <mutex>
 #include <condition_variable>
+#include <thread>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(__linux__)
+#include <cerrno>
+#include <climits>
+#include <ctime>
+#include <cstdint>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define ATOMIC_HAS_FUTEX 1
+#else
+#define ATOMIC_HAS_FUTEX 0
+#endif
 
 #if defined(_MSC_VER)
 #define ATOMIC_HAS_WAIT 0
@@ -59,6 +79,70 @@
 
 CYCOROUTINE_NAMESPACE_BEGIN
 
+//////////////////////////////////////////////////////////////////////////
+// Bounded spinning used before a blocking primitive falls back to the kernel.
+struct CYSpinWait
+{
+    // Spinning only pays off when the thread we wait for can run meanwhile.
+    static int SpinCount(int nSpinCount) noexcept
+    {
+        static const bool bMultiCore = std::thread::hardware_concurrency() > 1;
+        return bMultiCore ? nSpinCount : 0;
+    }
+
+    static void Relax() noexcept
+    {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        asm volatile("yield");
+#endif
+    }
+};
+
+#if ATOMIC_HAS_FUTEX
+//////////////////////////////////////////////////////////////////////////
+// Thin wrapper over the process-private futex calls, shared by the blocking primitives.
+struct CYFutex
+{
+    // Returns false when pTimeout (relative) elapsed before a wake-up.
+    static bool Wait(void* pWord, int32_t nExpected, const struct timespec* pTimeout = nullptr) noexcept
+    {
+        return ::syscall(SYS_futex, pWord, FUTEX_WAIT_PRIVATE, nExpected, pTimeout, nullptr, 0) == 0 || errno != ETIMEDOUT;
+    }
+
+    static void Wake(void* pWord, int32_t nCount) noexcept
+    {
+        ::syscall(SYS_futex, pWord, FUTEX_WAKE_PRIVATE, nCount, nullptr, nullptr, 0);
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Process-wide waiter bookkeeping keyed by address. A waiter that sees the new value
+// may free the atomic at once, so notifiers must not touch the object after storing to it.
+struct CYFutexTable
+{
+    struct alignas(64) CYBucket
+    {
+        std::atomic<int32_t> nWaiters{ 0 };
+        std::atomic<int32_t> nSequence{ 0 };
+    };
+
+    static CYBucket& Bucket(const void* pAddress) noexcept
+    {
+        static CYBucket s_arrBucket[k_nBucketCount];
+        return s_arrBucket[(reinterpret_cast<uintptr_t>(pAddress) >> 4) & (k_nBucketCount - 1)];
+    }
+
+    static constexpr size_t k_nBucketCount = 64;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Spins briefly, then sleeps on a futex. 32-bit values are waited on in place,
+// anything else through the bucket's sequence word bumped by every notify.
+// Notifiers only enter the kernel when someone is parked in the same bucket.
 template <typename T>
 class CYAtomicBase : public std::atomic<T>
 {
@@ -76,6 +160,163 @@ public:
         wait_impl(oldValue, order);
     }
 
+    // Returns false if deadline passed while the value still equaled oldValue.
+    template<class CLOCK, class DURATION>
+    bool wait_until(const T& oldValue, const std::chrono::time_point<CLOCK, DURATION>& deadline, std::memory_order order = std::memory_order_seq_cst)
+    {
+        while (Base::load(order) == oldValue)
+        {
+            const auto now = CLOCK::now();
+            if (now >= deadline)
+                return false;
+
+            const auto nRemain = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now).count();
+            const struct timespec timeout { static_cast<time_t>(nRemain / 1000000000), static_cast<long>(nRemain % 1000000000) };
+
+            auto& bucket = CYFutexTable::Bucket(this);
+            bucket.nWaiters.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            const auto nExpected = ExpectedWord(bucket, oldValue);
+            if (Base::load(std::memory_order_seq_cst) == oldValue)
+            {
+                CYFutex::Wait(FutexWord(bucket), nExpected, &timeout);
+            }
+
+            bucket.nWaiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        return true;
+    }
+
+    void notify_one()
+    {
+        notify_impl(1);
+    }
+
+    void notify_all()
+    {
+        notify_impl(INT_MAX);
+    }
+
+    void store(T v, std::memory_order order = std::memory_order_seq_cst)
+    {
+        Base::store(v, order);
+        notify_impl(INT_MAX);
+    }
+
+private:
+    static constexpr bool k_bInPlaceWord = sizeof(Base) == sizeof(int32_t) && alignof(Base) >= alignof(int32_t) && std::is_trivially_copyable_v<T>;
+    static constexpr int k_nSpinCount = 128;
+
+    void wait_impl(const T& oldValue, std::memory_order order)
+    {
+        for (int i = CYSpinWait::SpinCount(k_nSpinCount); i > 0; --i)
+        {
+            if (Base::load(order) != oldValue)
+                return;
+
+            CYSpinWait::Relax();
+        }
+
+        while (true)
+        {
+            auto& bucket = CYFutexTable::Bucket(this);
+            bucket.nWaiters.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            const auto nExpected = ExpectedWord(bucket, oldValue);
+            if (Base::load(std::memory_order_seq_cst) == oldValue)
+            {
+                CYFutex::Wait(FutexWord(bucket), nExpected);
+            }
+
+            bucket.nWaiters.fetch_sub(1, std::memory_order_relaxed);
+            if (Base::load(order) != oldValue)
+                return;
+        }
+    }
+
+    void notify_impl(int32_t nCount)
+    {
+        auto& bucket = CYFutexTable::Bucket(this);
+        if constexpr (!k_bInPlaceWord)
+        {
+            // The sequence word is shared by the bucket, so waking one could pick another atomic's waiter.
+            bucket.nSequence.fetch_add(1, std::memory_order_seq_cst);
+            nCount = INT_MAX;
+        }
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (bucket.nWaiters.load(std::memory_order_seq_cst) != 0)
+        {
+            // The kernel only hashes the address; a stale one costs at most a spurious wake-up.
+            CYFutex::Wake(FutexWord(bucket), nCount);
+        }
+    }
+
+    int32_t ExpectedWord(CYFutexTable::CYBucket& bucket, const T& oldValue) const noexcept
+    {
+        if constexpr (k_bInPlaceWord)
+        {
+            int32_t nWord;
+            std::memcpy(&nWord, &oldValue, sizeof(nWord));
+            return nWord;
+        }
+        else
+        {
+            return bucket.nSequence.load(std::memory_order_seq_cst);
+        }
+    }
+
+    void* FutexWord(CYFutexTable::CYBucket& bucket) noexcept
+    {
+        if constexpr (k_bInPlaceWord)
+        {
+            return static_cast<Base*>(this);
+        }
+        else
+        {
+            return &bucket.nSequence;
+        }
+    }
+};
+#else
+template <typename T>
+class CYAtomicBase : public std::atomic<T>
+{
+public:
+    using Base = std::atomic<T>;
+    using Base::Base;
+
+    void wait(const T& oldValue)
+    {
+        wait_impl(oldValue, std::memory_order_seq_cst);
+    }
+
+    void wait(const T& oldValue, std::memory_order order)
+    {
+        wait_impl(oldValue, order);
+    }
+
+    // Returns false if deadline passed while the value still equaled oldValue.
+    template<class CLOCK, class DURATION>
+    bool wait_until(const T& oldValue, const std::chrono::time_point<CLOCK, DURATION>& deadline, std::memory_order order = std::memory_order_seq_cst)
+    {
+        std::unique_lock<std::mutex> lock(mtx_);
+        while (this->load(order) == oldValue)
+        {
+            const auto now = CLOCK::now();
+            if (now >= deadline)
+                return false;
+
+            const auto nRemain = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+            cv_.wait_for(lock, (std::min)(nRemain, std::chrono::nanoseconds(std::chrono::milliseconds(100))));
+        }
+
+        return true;
+    }
+
     void notify_one()
     {
         notify_one_impl();
@@ -126,6 +367,7 @@ private:
     std::mutex mtx_;
     std::condition_variable cv_;
 };
+#endif
 
 template <typename T>
 #if ATOMIC_HAS_WAIT
@@ -133,5 +375,7 @@ using cy_atomic = std::atomic<T>;
 #else
 using cy_atomic = CYAtomicBase<T>;
 #endif
-
+
+CYCOROUTINE_NAMESPACE_END
+
 #endif // !__CY_ATOMIC_EX_HPP__
\ No newline at end of file
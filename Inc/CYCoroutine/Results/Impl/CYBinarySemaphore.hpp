@@ -44,9 +44,8 @@
 #define __CY_BINARY_SEMAPHORE_HPP__
 
 #include "CYCoroutine/CYCoroutineDefine.hpp"
+#include "CYCoroutine/Results/Impl/CYCountingSemaphore.hpp"
 
-#include <mutex>
-#include <condition_variable>
 #include <chrono>
 
 #if defined(__APPLE__) && defined(__clang__)
@@ -58,79 +57,9 @@
 
 CYCOROUTINE_NAMESPACE_BEGIN
 
-class BinarySemaphore
-{
-public:
-    explicit BinarySemaphore(ptrdiff_t desired)
-        : flag(desired > 0 ? 1 : 0)
-    {}
-
-#undef max
-    static constexpr ptrdiff_t max() noexcept
-    {
-        return 1;
-    }
-
-    void acquire()
-    {
-        std::unique_lock<std::mutex> lock(mtx);
-        cv.wait(lock, [&] { return flag == 1; });
-        flag = 0;
-    }
-
-    bool try_acquire()
-    {
-        std::unique_lock<std::mutex> lock(mtx);
-        if (flag == 1)
-        {
-            flag = 0;
-            return true;
-        }
-        return false;
-    }
-
-    template<class Rep, class Period>
-    bool try_acquire_for(const std::chrono::duration<Rep, Period>& dur)
-    {
-        std::unique_lock<std::mutex> lock(mtx);
-        if (!cv.wait_for(lock, dur, [&] { return flag == 1; }))
-            return false;
-
-        flag = 0;
-        return true;
-    }
-
-    template<class Clock, class Duration>
-    bool try_acquire_until(const std::chrono::time_point<Clock, Duration>& tp)
-    {
-        std::unique_lock<std::mutex> lock(mtx);
-        if (!cv.wait_until(lock, tp, [&] { return flag == 1; }))
-            return false;
-
-        flag = 0;
-        return true;
-    }
-
-    // release(update) —  C++20 std::binary_semaphore
-    void release(ptrdiff_t update = 1)
-    {
-        if (update < 1)
-            return;
-
-        std::unique_lock<std::mutex> lock(mtx);
-
-        const bool was_zero = (flag == 0);
-        flag = 1;
-
-        if (was_zero)
-            cv.notify_one();
-    }
-
-private:
-    std::mutex mtx;
-    std::condition_variable cv;
-    int flag = 0;  // 0 = unavailable, 1 = available
-};
+// Binary flavour of the lock-free CYCountingSemaphore: release() on an
+// available semaphore is a no-op, as with the previous mutex based version.
+using BinarySemaphore = CYCountingSemaphore<1>;
 
 #if defined(__APPLE__)
 using cy_binary_semaphore = BinarySemaphore;
@@ -50,6 +50,7 @@
 
 CYCOROUTINE_NAMESPACE_BEGIN
 
+class CYExecutor;
 class CYCOROUTINE_API CYAwaitViaFunctor
 {
 public:
@@ -59,6 +60,25 @@ public:
 
     void operator()() noexcept;
 
+public:
+    // Posts handleCaller to executor. If the executor throws, the dropped task resumes the
+    // coroutine inline with *pbInterrupted set, so there is nothing left for the caller to do.
+    static void Post(CYExecutor& executor, coroutine_handle<void> handleCaller, bool* pbInterrupted) noexcept;
+
+    // For await_resume of a waiter that was handed something (a lock, permits) before its resume
+    // task got dropped: funcHandBack passes it on so nobody waits for it forever, then the await fails.
+    template<class HAND_BACK_TYPE>
+    static void HandBackIfInterrupted(bool bInterrupted, HAND_BACK_TYPE&& funcHandBack)
+    {
+        if (bInterrupted)
+        {
+            funcHandBack();
+            ThrowInterrupted();
+        }
+    }
+
+    [[noreturn]] static void ThrowInterrupted();
+
 private:
     bool* m_pbInterrupted;
     coroutine_handle<void> m_handleCaller;
@@ -87,6 +107,64 @@ private:
     static const CYResultStateBase* k_pDoneProcessing;
 };
 
+//////////////////////////////////////////////////////////////////////////
+// Countdown shared by a whole set of results: the awaiting coroutine holds one extra
+// count while it registers, and whoever drops the count to zero resumes it.
+class CYCOROUTINE_API CYCountdownContext
+{
+public:
+    CYCountdownContext(size_t nCount) noexcept;
+
+public:
+    void SetCaller(coroutine_handle<void> handleCaller) noexcept;
+    void Arrive() noexcept;
+    bool Suspend(size_t nArrived) noexcept;
+
+private:
+    std::atomic_size_t m_nPending;
+    coroutine_handle<void> m_handleCaller;
+};
+
+//////////////////////////////////////////////////////////////////////////
+class CYCompletionContext;
+struct CYCOROUTINE_API CYCompletionNode
+{
+    CYCompletionNode* next = nullptr;
+    CYCompletionContext* pContext = nullptr;
+    std::atomic_bool bQueued{ false };
+
+    // consumer side only: the index was handed out by Next()/TryNext(), its result is free to take.
+    bool bHandedOut = false;
+};
+
+// Completion queue shared by a set of results: every finished result pushes its node
+// (lock-free, from the producer thread), a single consumer pops them in completion order.
+class CYCOROUTINE_API CYCompletionContext
+{
+public:
+    void Push(CYCompletionNode& objNode) noexcept;
+    CYCompletionNode* TryPop() noexcept;
+    bool Suspend(coroutine_handle<void> handleCaller) noexcept;
+
+private:
+    std::atomic<CYCompletionNode*> m_pHead{ nullptr };
+    CYCompletionNode* m_pReady = nullptr;
+    coroutine_handle<void> m_handleWaiter;
+
+    static CYCompletionNode* WaiterConstant() noexcept;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Callback parked directly in a result's consumer slot, Run() is called exactly once
+// by the producer (or by the registering thread if the result is already done) and
+// releases the continuation.
+class CYCOROUTINE_API CYContinuationBase
+{
+public:
+    virtual ~CYContinuationBase() noexcept = default;
+    virtual void Run() noexcept = 0;
+};
+
 //////////////////////////////////////////////////////////////////////////
 class CYSharedResultStateBase;
 class CYCOROUTINE_API CYConsumerContext
@@ -96,11 +174,15 @@ public:
 
     void Clear() noexcept;
     void ResumeConsumer(CYResultStateBase& self) const;
+    coroutine_handle<void> TransferConsumer(CYResultStateBase& self) const;
 
     void SetAwaitHandle(coroutine_handle<void> handleCaller) noexcept;
-    void SetWaitForContext(const SharePtr<cy_binary_semaphore>& ptrWaitCtx) noexcept;
+    void SetWaitForContext(cy_binary_semaphore* pWaitCtx) noexcept;
     void SetWhenAnyContext(const SharePtr<CYWhenAnyContext>& ptrWhenAnyCtx) noexcept;
     void SetSharedContext(const SharePtr<CYSharedResultStateBase>& ptrSharedCtx) noexcept;
+    void SetCompletionContext(CYCompletionNode* pCompletionNode) noexcept;
+    void SetCountdownContext(CYCountdownContext* pCountdownCtx) noexcept;
+    void SetContinuation(CYContinuationBase* pContinuation) noexcept;
 
 private:
     void Destroy() noexcept;
@@ -108,15 +190,18 @@ private:
 private:
     enum class EConsumerStatus
     {
-        STATUS_CONSUMER_IDLE, STATUS_CONSUMER_AWAIT, STATUS_CONSUMER_WAITFOR, STATUS_CONSUMER_WHENANY, STATUS_CONSUMER_SHARED
+        STATUS_CONSUMER_IDLE, STATUS_CONSUMER_AWAIT, STATUS_CONSUMER_WAITFOR, STATUS_CONSUMER_WHENANY, STATUS_CONSUMER_SHARED, STATUS_CONSUMER_COMPLETION, STATUS_CONSUMER_COUNTDOWN, STATUS_CONSUMER_CONTINUATION
     };
 
     union CYStorage
     {
         coroutine_handle<void> handleCaller;
-        SharePtr<cy_binary_semaphore> wait_for_ctx;
+        cy_binary_semaphore* pWaitForCtx;
         SharePtr<CYWhenAnyContext> ptrWhenAnyCtx;
         WeakPtr<CYSharedResultStateBase> ptrSharedCtx;
+        CYCompletionNode* pCompletionNode;
+        CYCountdownContext* pCountdownCtx;
+        CYContinuationBase* pContinuation;
 
         CYStorage() noexcept
         {
@@ -44,7 +44,9 @@
 #define __CY_CYCountingSemaphore_HPP__
 
 #include "CYCoroutine/CYCoroutineDefine.hpp"
+#include "CYCoroutine/Results/Impl/CYAtomic.hpp"
 
+#include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <limits>
@@ -61,8 +63,119 @@
 
 CYCOROUTINE_NAMESPACE_BEGIN
 
-// A portable CYCountingSemaphore compatible with C++20 std::CYCountingSemaphore
-// Template parameter Max defines the maximum count (default: max(ptrdiff_t))
+//////////////////////////////////////////////////////////////////////////
+// Parking spot of CYCountingSemaphore: counts pending wake-ups and blocks
+// on a futex on Linux, on a condition_variable elsewhere.
+class CYSemaphoreWaiter
+{
+public:
+    CYSemaphoreWaiter() = default;
+    CYSemaphoreWaiter(const CYSemaphoreWaiter&) = delete;
+    CYSemaphoreWaiter& operator=(const CYSemaphoreWaiter&) = delete;
+
+#if ATOMIC_HAS_FUTEX
+    void Signal(int32_t nCount) noexcept
+    {
+        m_nWakeups.fetch_add(nCount, std::memory_order_release);
+        CYFutex::Wake(&m_nWakeups, nCount);
+    }
+
+    void Wait() noexcept
+    {
+        while (!TryConsume())
+        {
+            CYFutex::Wait(&m_nWakeups, 0);
+        }
+    }
+
+    template<class Clock, class Duration>
+    bool WaitUntil(const std::chrono::time_point<Clock, Duration>& absTime) noexcept
+    {
+        while (!TryConsume())
+        {
+            const auto nRemaining = std::chrono::duration_cast<std::chrono::nanoseconds>(absTime - Clock::now()).count();
+            if (nRemaining <= 0)
+            {
+                return false;
+            }
+
+            struct timespec objTimeout;
+            objTimeout.tv_sec = static_cast<time_t>(nRemaining / 1000000000);
+            objTimeout.tv_nsec = static_cast<long>(nRemaining % 1000000000);
+            CYFutex::Wait(&m_nWakeups, 0, &objTimeout);
+        }
+
+        return true;
+    }
+
+private:
+    bool TryConsume() noexcept
+    {
+        auto nWakeups = m_nWakeups.load(std::memory_order_relaxed);
+        while (nWakeups > 0)
+        {
+            if (m_nWakeups.compare_exchange_weak(nWakeups, nWakeups - 1, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+private:
+    std::atomic<int32_t> m_nWakeups{ 0 };
+#else
+    void Signal(int32_t nCount)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_nWakeups += nCount;
+        }
+
+        if (nCount == 1)
+        {
+            m_condition.notify_one();
+        }
+        else
+        {
+            m_condition.notify_all();
+        }
+    }
+
+    void Wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this] { return m_nWakeups > 0; });
+        --m_nWakeups;
+    }
+
+    template<class Clock, class Duration>
+    bool WaitUntil(const std::chrono::time_point<Clock, Duration>& absTime)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_condition.wait_until(lock, absTime, [this] { return m_nWakeups > 0; }))
+        {
+            return false;
+        }
+
+        --m_nWakeups;
+        return true;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    int32_t m_nWakeups = 0;
+#endif
+};
+
+//////////////////////////////////////////////////////////////////////////
+// A portable CYCountingSemaphore compatible with C++20 std::counting_semaphore.
+// Template parameter Max defines the maximum count (default: max(ptrdiff_t)).
+// A negative count is the number of parked threads: acquire/release are one
+// atomic operation when nobody has to sleep, and release only touches the
+// waiter (futex) for threads that actually parked. Releases saturate at Max.
 template<ptrdiff_t Max = std::numeric_limits<ptrdiff_t>::max()>
 class CYCountingSemaphore
 {
@@ -70,10 +183,10 @@ public:
     static_assert(Max > 0, "Max must be positive");
 
     using ptrdiff_type = ptrdiff_t;
-#undef min
+#undef min
     // Construct with initial count (must be in [0, Max])
     explicit CYCountingSemaphore(ptrdiff_type desired = 0)
-        : count_(std::max<ptrdiff_type>(0, std::min(desired, Max)))
+        : m_nCount(std::max<ptrdiff_type>(0, std::min(desired, Max)))
     {
     }
 
@@ -86,20 +199,29 @@ public:
     // acquire (blocking)
     void acquire()
     {
-        std::unique_lock<std::mutex> lock(mtx_);
-        cv_.wait(lock, [&] { return count_ > 0; });
-        --count_;
+        if (TrySpin())
+        {
+            return;
+        }
+
+        if (m_nCount.fetch_sub(1, std::memory_order_acquire) <= 0)
+        {
+            m_objWaiter.Wait();
+        }
     }
 
     // try acquire (non-blocking)
     bool try_acquire() noexcept
     {
-        std::lock_guard<std::mutex> lock(mtx_);
-        if (count_ > 0)
+        auto nCount = m_nCount.load(std::memory_order_relaxed);
+        while (nCount > 0)
         {
-            --count_;
-            return true;
+            if (m_nCount.compare_exchange_weak(nCount, nCount - 1, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                return true;
+            }
         }
+
         return false;
     }
 
@@ -107,59 +229,95 @@ public:
     template<class Rep, class Period>
     bool try_acquire_for(const std::chrono::duration<Rep, Period>& rel_time)
     {
-        std::unique_lock<std::mutex> lock(mtx_);
-        if (!cv_.wait_for(lock, rel_time, [&] { return count_ > 0; }))
-            return false;
-        --count_;
-        return true;
+        return try_acquire_until(std::chrono::steady_clock::now() + rel_time);
     }
 
     // try acquire until time_point
     template<class Clock, class Duration>
     bool try_acquire_until(const std::chrono::time_point<Clock, Duration>& abs_time)
     {
-        std::unique_lock<std::mutex> lock(mtx_);
-        if (!cv_.wait_until(lock, abs_time, [&] { return count_ > 0; }))
-            return false;
-        --count_;
-        return true;
+        if (TrySpin())
+        {
+            return true;
+        }
+
+        if (m_nCount.fetch_sub(1, std::memory_order_acquire) > 0)
+        {
+            return true;
+        }
+
+        if (m_objWaiter.WaitUntil(abs_time))
+        {
+            return true;
+        }
+
+        // Timed out: withdraw from the count, unless a release already picked us,
+        // in which case its wake-up is on the way and must be consumed.
+        auto nCount = m_nCount.load(std::memory_order_relaxed);
+        while (true)
+        {
+            if (nCount >= 0)
+            {
+                m_objWaiter.Wait();
+                return true;
+            }
+
+            if (m_nCount.compare_exchange_weak(nCount, nCount + 1, std::memory_order_relaxed))
+            {
+                return false;
+            }
+        }
     }
 
     // release n permits (default 1)
-    // increases count by at most (Max - count_), and notifies up to that many waiters
+    // increases count by at most (Max - count), and wakes up as many parked threads as it can satisfy
     void release(ptrdiff_type update = 1)
     {
         if (update <= 0) return; // ignore non-positive updates
 
-        ptrdiff_type to_notify = 0;
+        auto nCount = m_nCount.load(std::memory_order_relaxed);
+        ptrdiff_type nIncrement = 0;
+        do
+        {
+            // Room left below Max; with parked threads Max - nCount can overflow, so clamp it.
+            const ptrdiff_type nRoom = (nCount < 0 && Max > std::numeric_limits<ptrdiff_type>::max() + nCount)
+                ? std::numeric_limits<ptrdiff_type>::max() : Max - nCount;
+            nIncrement = std::min(update, nRoom);
+            if (nIncrement == 0)
+            {
+                return;
+            }
+        } while (!m_nCount.compare_exchange_weak(nCount, nCount + nIncrement, std::memory_order_release, std::memory_order_relaxed));
 
+        if (nCount < 0)
         {
-            std::lock_guard<std::mutex> lock(mtx_);
-            // clamp the new count to [0, Max]
-            ptrdiff_type old = count_;
-            // compute new count in safe way
-            ptrdiff_type available_space = Max - old;
-            ptrdiff_type inc = (update <= available_space) ? update : available_space;
-            count_ = old + inc;
-            to_notify = inc;
+            m_objWaiter.Signal(static_cast<int32_t>(std::min(-nCount, nIncrement)));
         }
+    }
+
+private:
+    static constexpr int k_nSpinCount = 64;
 
-        // If there are more waiters than inc, we need to wake up inc of them.
-        // We notify in a loop to allow up to 'to_notify' waiting threads to wake.
-        // Using notify_one repeatedly is fine; spurious wakeups or race
-        // will be handled by the waiting predicate.
-        for (ptrdiff_type i = 0; i < to_notify; ++i)
+    bool TrySpin() noexcept
+    {
+        for (int i = CYSpinWait::SpinCount(k_nSpinCount); i > 0; --i)
         {
-            cv_.notify_one();
+            if (try_acquire())
+            {
+                return true;
+            }
+
+            CYSpinWait::Relax();
         }
+
+        return try_acquire();
     }
 
 private:
-    std::mutex mtx_;
-    std::condition_variable cv_;
-    ptrdiff_type count_ = 0;
-};
-
+    std::atomic<ptrdiff_type> m_nCount;
+    CYSemaphoreWaiter m_objWaiter;
+};
+
 #if defined(__APPLE__)
 template <ptrdiff_t Max = std::numeric_limits<ptrdiff_t>::max()>
 using cy_counting_semaphore = CYCountingSemaphore<Max>;
@@ -49,6 +49,8 @@
 #include "CYCoroutine/Results/Impl/CYAtomic.hpp"
 #include "CYCoroutine/Results/Impl/CYBinarySemaphore.hpp"
 
+CYCOROUTINE_NAMESPACE_BEGIN
+
 class CYCOROUTINE_API CYResultStateBase
 {
 public:
@@ -64,11 +66,18 @@ public:
     EResultState WhenAny(const SharePtr<CYWhenAnyContext>& ptrWhenAnyState) noexcept;
 
     void Share(const SharePtr<CYSharedResultStateBase>& resultState) noexcept;
-    void TryRewindConsumer() noexcept;
+    bool WhenComplete(CYCompletionNode& objNode) noexcept;
+    bool WhenALL(CYCountdownContext& objCountdown) noexcept;
+    bool Then(CYContinuationBase& objContinuation) noexcept;
+    bool TryRewindConsumer() noexcept;
+    bool ProducerDone() const noexcept;
 
 protected:
     void AssertDone() const noexcept;
 
+    // Per-thread semaphore lent to WaitFor/WaitUntil; it is always drained before being handed back.
+    static cy_binary_semaphore& WaitForSemaphore() noexcept;
+
 protected:
     cy_atomic<EResultState> m_eResultState{ EResultState::STATE_RESULT_IDLE };
     CYConsumerContext m_objConsumer;
@@ -115,8 +124,8 @@ public:
             return m_objProducer.Status();
         }
 
-        const auto objWaitCtx = MakeShared<cy_binary_semaphore>(0);
-        m_objConsumer.SetWaitForContext(objWaitCtx);
+        auto& objWaitCtx = WaitForSemaphore();
+        m_objConsumer.SetWaitForContext(&objWaitCtx);
 
         std::atomic_thread_fence(std::memory_order_release);
 
@@ -128,7 +137,7 @@ public:
             return m_objProducer.Status();
         }
 
-        if (objWaitCtx->try_acquire_for(nDuration + std::chrono::milliseconds(1)))
+        if (objWaitCtx.try_acquire_for(nDuration + std::chrono::milliseconds(1)))
         {
             const auto status = m_eResultState.load(std::memory_order_acquire);
             (void)status;
@@ -141,6 +150,9 @@ public:
 
         if (!bIdle1)
         {
+            // The producer already claimed the consumer slot: take its release so the
+            // semaphore goes back to this thread empty.
+            objWaitCtx.acquire();
             AssertDone();
             return m_objProducer.Status();
         }
@@ -196,35 +208,30 @@ public:
         const auto state_before = this->m_eResultState.exchange(EResultState::STATE_RESULT_PRODUCER_DONE, std::memory_order_acq_rel);
         assert(state_before != EResultState::STATE_RESULT_PRODUCER_DONE);
 
-        switch (state_before)
-        {
-        case EResultState::STATE_RESULT_CONSUMER_SET:
+        if (state_before == EResultState::STATE_RESULT_CONSUMER_SET)
         {
             return m_objConsumer.ResumeConsumer(*this);
         }
 
-        case EResultState::STATE_RESULT_IDLE:
-        {
-            return;
-        }
+        OnProducerDone(state_before);
+    }
 
-        case EResultState::STATE_RESULT_CONSUMER_WAIT:
-        {
-            return m_eResultState.notify_one();
-        }
+    // Same as CompleteProducer, but an awaiting coroutine is returned instead of being resumed,
+    // so the producer's final_suspend can transfer to it without growing the stack.
+    coroutine_handle<void> CompleteProducerTransfer(coroutine_handle<void> handleDone) noexcept
+    {
+        m_handleDone = handleDone;
 
-        case EResultState::STATE_RESULT_CONSUMER_DONE:
-        {
-            return DeleteSelf(this);
-        }
+        const auto state_before = this->m_eResultState.exchange(EResultState::STATE_RESULT_PRODUCER_DONE, std::memory_order_acq_rel);
+        assert(state_before != EResultState::STATE_RESULT_PRODUCER_DONE);
 
-        default:
+        if (state_before == EResultState::STATE_RESULT_CONSUMER_SET)
         {
-            break;
-        }
+            return m_objConsumer.TransferConsumer(*this);
         }
 
-        assert(false);
+        OnProducerDone(state_before);
+        return std::noop_coroutine();
     }
 
     void CompleteConsumer() noexcept
@@ -253,6 +260,34 @@ public:
     }
 
 private:
+    void OnProducerDone(EResultState state_before) noexcept
+    {
+        switch (state_before)
+        {
+        case EResultState::STATE_RESULT_IDLE:
+        {
+            return;
+        }
+
+        case EResultState::STATE_RESULT_CONSUMER_WAIT:
+        {
+            return m_eResultState.notify_one();
+        }
+
+        case EResultState::STATE_RESULT_CONSUMER_DONE:
+        {
+            return DeleteSelf(this);
+        }
+
+        default:
+        {
+            break;
+        }
+        }
+
+        assert(false);
+    }
+
     static void DeleteSelf(CYResultState<TYPE>* pState) noexcept
     {
         auto handleDone = pState->m_handleDone;
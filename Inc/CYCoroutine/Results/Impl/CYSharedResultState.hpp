@@ -45,7 +45,6 @@
 
 #include "CYCoroutine/CYCoroutineDefine.hpp"
 #include "CYCoroutine/Results/Impl/CYResultState.hpp"
-#include "CYCoroutine/Results/Impl/CYCountingSemaphore.hpp"
 
 #include <atomic>
 #include <chrono>
@@ -67,10 +66,16 @@ struct CYSharedResultHelper
 };
 
 //////////////////////////////////////////////////////////////////////////
+class CYExecutor;
 struct CYCOROUTINE_API CYSharedAwaitContext
 {
     CYSharedAwaitContext* next = nullptr;
     coroutine_handle<void> handleCaller;
+
+    // Optional gate for awaiters racing several sources: called by the completing thread before
+    // anything is resumed, handleCaller is only resumed if it returns true. A context that
+    // returned false may be released by its owner right away and is not touched again.
+    bool (*pfnClaim)(CYSharedAwaitContext& self) noexcept = nullptr;
 };
 
 class CYCOROUTINE_API CYSharedResultStateBase
@@ -86,6 +91,14 @@ public:
 
     bool await(CYSharedAwaitContext& awaiter) noexcept;
 
+    // Unlinks an awaiter that is still queued, false once the result finished and the awaiter
+    // is (or already was) being resumed.
+    bool TryRemove(CYSharedAwaitContext& awaiter) noexcept;
+
+    // Awaiters are resumed in batches of nBatchSize on ptrExecutor instead of one after another
+    // on the completing thread, which only runs the first batch itself. Set before sharing.
+    void SetResumeExecutor(const SharePtr<CYExecutor>& ptrExecutor, size_t nBatchSize) noexcept;
+
     template<class duration_unit, class ratio>
     EResultStatus WaitFor(std::chrono::duration<duration_unit, ratio> duration)
     {
@@ -96,21 +109,21 @@ public:
     template<class clock, class duration>
     EResultStatus WaitUntil(const std::chrono::time_point<clock, duration>& timeoutTime)
     {
-        while ((Status() == EResultStatus::STATUS_RESULT_IDLE) && (clock::now() < timeoutTime))
-        {
-            const auto res = m_semaphore.try_acquire_until(timeoutTime);
-            (void)res;
-        }
-
+        m_status.wait_until(EResultStatus::STATUS_RESULT_IDLE, timeoutTime, std::memory_order_acquire);
         return Status();
     }
 
+protected:
+    void ResumeAwaiters() noexcept;
+
 protected:
     cy_atomic<EResultStatus> m_status{ EResultStatus::STATUS_RESULT_IDLE };
     std::atomic<CYSharedAwaitContext*> m_awaiters{ nullptr };
-    cy_counting_semaphore<> m_semaphore{ 0 };
+    SharePtr<CYExecutor> m_ptrResumeExecutor;
+    size_t m_nBatchSize = 0;
 
     static CYSharedAwaitContext* ResultReadyConstant() noexcept;
+    static bool Locked(CYSharedAwaitContext* pAwaiters) noexcept;
 };
 
 template<class TYPE>
@@ -144,39 +157,11 @@ public:
 
     void OnResultFinished() noexcept override
     {
+        // blocking waiters (Wait/WaitFor/WaitUntil) all sleep on m_status, one broadcast wakes them.
         m_status.store(m_result_state->Status(), std::memory_order_release);
         m_status.notify_all();
 
-        /* theoretically buggish, practically there's no way
-           that we'll have more than max(ptrdiff_t) / 2 waiters.
-           on 64 bits, that's 2^62 waiters, on 32 bits thats 2^30 waiters.
-           memory will run out before enough tasks could be created to wait this synchronously
-        */
-        m_semaphore.release(m_semaphore.max() / 2);
-
-        auto k_result_ready = ResultReadyConstant();
-        auto awaiters = m_awaiters.exchange(k_result_ready, std::memory_order_acq_rel);
-
-        CYSharedAwaitContext* current = awaiters;
-        CYSharedAwaitContext* prev = nullptr, * next = nullptr;
-
-        while (current != nullptr)
-        {
-            next = current->next;
-            current->next = prev;
-            prev = current;
-            current = next;
-        }
-
-        awaiters = prev;
-
-        while (awaiters != nullptr)
-        {
-            assert(static_cast<bool>(awaiters->handleCaller));
-            auto handleCaller = awaiters->handleCaller;
-            awaiters = awaiters->next;
-            handleCaller();
-        }
+        ResumeAwaiters();
     }
 
 private:
@@ -0,0 +1,132 @@
+/*
+ * CYCoroutine License
+ * -----------
+ *
+ * CYCoroutine is licensed under the terms of the MIT license reproduced below.
+ * This means that CYCoroutine is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+/*
+ * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ * VERSION:  1.0.0
+ * PURPOSE:  A cross-platform efficient and stable Coroutine library.
+ * CREATION: 2026.10.18
+ * LCHANGE:  2026.10.18
+ * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+ */
+
+#ifndef __CY_ASYNC_BARRIER_CORO_HPP__
+#define __CY_ASYNC_BARRIER_CORO_HPP__
+
+#include "CYCoroutine/CYCoroutineDefine.hpp"
+#include "CYCoroutine/Threads/CYAsyncWaitStack.hpp"
+
+#include <atomic>
+#include <type_traits>
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+class CYAsyncBarrierBase;
+class CYCOROUTINE_API CYAsyncBarrierAwaiter : private CYAsyncWaitNode
+{
+public:
+    CYAsyncBarrierAwaiter(CYAsyncBarrierBase& parent, SharePtr<CYExecutor> ptrResumeExecutor) noexcept;
+
+    constexpr bool  await_ready() const noexcept { return false; }
+    bool            await_suspend(coroutine_handle<void> handleCaller) noexcept;
+    void            await_resume() const;
+
+private:
+    CYAsyncBarrierBase& m_parent;
+};
+
+//////////////////////////////////////////////////////////////////////////
+/*
+ * Reusable barrier for coroutines: co_await ArriveAndWait(executor) suspends until all
+ * participants of the phase arrived. The last one to arrive runs the completion step, starts
+ * the next phase and goes on inline, the others are resumed on their executors. Arriving is
+ * a CAS on the waiter stack and a decrement of the counter, nothing is allocated per phase.
+ */
+class CYCOROUTINE_API CYAsyncBarrierBase
+{
+    friend class CYAsyncBarrierAwaiter;
+public:
+    explicit CYAsyncBarrierBase(size_t nExpected);
+    virtual ~CYAsyncBarrierBase() noexcept = default;
+
+    CYAsyncBarrierBase(const CYAsyncBarrierBase&) = delete;
+    CYAsyncBarrierBase& operator=(const CYAsyncBarrierBase&) = delete;
+
+public:
+    CYAsyncBarrierAwaiter   ArriveAndWait(SharePtr<CYExecutor> ptrResumeExecutor);
+    size_t                  Expected() const noexcept;
+
+protected:
+    // runs once per phase on the last arriving coroutine, before anybody is resumed.
+    virtual void            CompletePhase() noexcept = 0;
+
+private:
+    bool                    Arrive(CYAsyncWaitNode& node) noexcept;
+
+private:
+    const size_t            m_nExpected;
+    std::atomic<size_t>     m_nRemaining;
+    CYAsyncWaitStack        m_stackWaiters;
+};
+
+//////////////////////////////////////////////////////////////////////////
+struct CYAsyncBarrierNoCompletion
+{
+    void operator()() const noexcept {}
+};
+
+template<class COMPLETION_TYPE = CYAsyncBarrierNoCompletion>
+class CYAsyncBarrier final : public CYAsyncBarrierBase
+{
+    static_assert(std::is_nothrow_invocable_v<COMPLETION_TYPE&>, "CYAsyncBarrier - <<COMPLETION_TYPE>> must be invocable with no args and must not throw.");
+
+public:
+    explicit CYAsyncBarrier(size_t nExpected, COMPLETION_TYPE completion = COMPLETION_TYPE())
+        : CYAsyncBarrierBase(nExpected)
+        , m_completion(std::move(completion))
+    {
+    }
+
+protected:
+    void CompletePhase() noexcept override
+    {
+        m_completion();
+    }
+
+private:
+    COMPLETION_TYPE m_completion;
+};
+
+CYCOROUTINE_NAMESPACE_END
+
+#endif //__CY_ASYNC_BARRIER_CORO_HPP__
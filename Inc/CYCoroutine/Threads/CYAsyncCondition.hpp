@@ -43,35 +43,46 @@
 #ifndef __CY_ASYNC_CONDITION_CORO_HPP__
 #define __CY_ASYNC_CONDITION_CORO_HPP__
 
-#include "CYCommon/Common/CYList.hpp"
-
 #include "CYCoroutine/CYCoroutineDefine.hpp"
 #include "CYCoroutine/Results/CYLazyResult.hpp"
 #include "CYCoroutine/Threads/CYAsyncLock.hpp"
+#include "CYCoroutine/Threads/CYCancellation.hpp"
 
 CYCOROUTINE_NAMESPACE_BEGIN
 
 //////////////////////////////////////////////////////////////////////////
 class CYAsyncCondition;
-class CYCOROUTINE_API CYAWaiter
+class CYCOROUTINE_API CYAWaiter : private CYCancellationCallback
 {
 public:
-    CYAWaiter(CYAsyncCondition& parent, CScopedAsyncLock& lock) noexcept;
+    CYAWaiter(CYAsyncCondition& parent, CScopedAsyncLock& lock, SharePtr<CYExecutor> ptrResumeExecutor, CYCancellationToken token = {}) noexcept;
     virtual ~CYAWaiter() noexcept = default;
 
 public:
     constexpr bool  await_ready() const noexcept;
     void            await_suspend(coroutine_handle<void> handleCaller);
-    void            await_resume() const noexcept;
+    void            await_resume();
     void            resume() noexcept;
 
 public:
+    // links of the condition's waiter queue, guarded by its lock, so a cancelled waiter leaves in O(1).
+    CYAWaiter*        prev = nullptr;
     CYAWaiter*        next = nullptr;
+    bool              queued = false;
+
+private:
+    // a cancelled waiter leaves the condition and re-acquires the lock like a notified one.
+    void OnCancel() noexcept override;
 
 private:
     CYAsyncCondition& m_parent;
     CScopedAsyncLock& m_lock;
-    coroutine_handle<void> m_handleCaller;
+
+    // notifying moves this node onto the lock's waiter queue, the lock resumes us once it's ours.
+    CAsyncLockAwaiter m_lockAwaiter;
+
+    CYCancellationToken m_token;
+    bool m_bCancelled = false;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -91,7 +102,19 @@ public:
         static_assert(std::is_invocable_r_v<bool, PREDICATE_TYPE>, "Given predicate isn't invocable with no args, or does not return a type which is or convertible to bool.");
 
         VerifyAwaitParams(ptrResumeExecutor, lock);
-        return AWaitImpl(std::move(ptrResumeExecutor), lock, pred);
+        return AWaitImpl(std::move(ptrResumeExecutor), lock, pred, {});
+    }
+
+    // a cancelled wait returns with the lock re-acquired and fails with operation_canceled.
+    CYLazyResult<void> await(SharePtr<CYExecutor> ptrResumeExecutor, CScopedAsyncLock& lock, CYCancellationToken token);
+
+    template<class PREDICATE_TYPE>
+    CYLazyResult<void> await(SharePtr<CYExecutor> ptrResumeExecutor, CScopedAsyncLock& lock, PREDICATE_TYPE pred, CYCancellationToken token)
+    {
+        static_assert(std::is_invocable_r_v<bool, PREDICATE_TYPE>, "Given predicate isn't invocable with no args, or does not return a type which is or convertible to bool.");
+
+        VerifyAwaitParams(ptrResumeExecutor, lock);
+        return AWaitImpl(std::move(ptrResumeExecutor), lock, pred, std::move(token));
     }
 
     void NotifyOne();
@@ -101,10 +124,10 @@ private:
     CYAsyncCondition(const CYAsyncCondition&) noexcept = delete;
     CYAsyncCondition(CYAsyncCondition&&) noexcept = delete;
 
-    CYLazyResult<void> AWaitImpl(SharePtr<CYExecutor> ptrResumeExecutor, CScopedAsyncLock& lock);
+    CYLazyResult<void> AWaitImpl(SharePtr<CYExecutor> ptrResumeExecutor, CScopedAsyncLock& lock, CYCancellationToken token);
 
     template<class PREDICATE_TYPE>
-    CYLazyResult<void> AWaitImpl(SharePtr<CYExecutor> ptrResumeExecutor, CScopedAsyncLock& lock, PREDICATE_TYPE pred)
+    CYLazyResult<void> AWaitImpl(SharePtr<CYExecutor> ptrResumeExecutor, CScopedAsyncLock& lock, PREDICATE_TYPE pred, CYCancellationToken token)
     {
         while (true)
         {
@@ -114,15 +137,21 @@ private:
                 break;
             }
 
-            co_await AWaitImpl(ptrResumeExecutor, lock);
+            co_await AWaitImpl(ptrResumeExecutor, lock, token);
         }
     }
 
+    // called with m_lock held.
+    void PushBack(CYAWaiter& awaiter) noexcept;
+    CYAWaiter* PopFront() noexcept;
+    bool Remove(CYAWaiter& awaiter) noexcept;
+
     static void VerifyAwaitParams(const SharePtr<CYExecutor>& ptrResumeExecutor, const CScopedAsyncLock& lock);
 
 private:
     std::mutex          m_lock;
-    CYList<CYAWaiter>   m_awaiters;
+    CYAWaiter*          m_pHead = nullptr;
+    CYAWaiter*          m_pTail = nullptr;
 
 };
 CYCOROUTINE_NAMESPACE_END
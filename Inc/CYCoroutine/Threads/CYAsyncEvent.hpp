@@ -0,0 +1,104 @@
+/*
+ * CYCoroutine License
+ * -----------
+ *
+ * CYCoroutine is licensed under the terms of the MIT license reproduced below.
+ * This means that CYCoroutine is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+/*
+ * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ * VERSION:  1.0.0
+ * PURPOSE:  A cross-platform efficient and stable Coroutine library.
+ * CREATION: 2026.10.18
+ * LCHANGE:  2026.10.18
+ * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+ */
+
+#ifndef __CY_ASYNC_EVENT_CORO_HPP__
+#define __CY_ASYNC_EVENT_CORO_HPP__
+
+#include "CYCoroutine/CYCoroutineDefine.hpp"
+#include "CYCoroutine/Threads/CYAsyncWaitStack.hpp"
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+enum class EAsyncEventMode
+{
+    // Set() releases every waiter and keeps the event set until Reset().
+    EVENT_MANUAL_RESET,
+    // Set() releases one waiter, the event resets itself as soon as somebody got through.
+    EVENT_AUTO_RESET
+};
+
+class CYAsyncEvent;
+class CYCOROUTINE_API CYAsyncEventAwaiter : private CYAsyncWaitNode
+{
+public:
+    CYAsyncEventAwaiter(CYAsyncEvent& parent, SharePtr<CYExecutor> ptrResumeExecutor) noexcept;
+
+    bool            await_ready() noexcept;
+    bool            await_suspend(coroutine_handle<void> handleCaller) noexcept;
+    void            await_resume();
+
+private:
+    CYAsyncEvent&   m_parent;
+};
+
+//////////////////////////////////////////////////////////////////////////
+/*
+ * Event for coroutines: co_await Wait(executor) goes on right away while the event is set
+ * and suspends otherwise, without blocking the worker. Waiters are resumed on their own
+ * executors, the awaiter lives in the awaiting frame and waiting allocates nothing.
+ */
+class CYCOROUTINE_API CYAsyncEvent
+{
+    friend class CYAsyncEventAwaiter;
+public:
+    explicit CYAsyncEvent(EAsyncEventMode eMode = EAsyncEventMode::EVENT_MANUAL_RESET, bool bInitiallySet = false) noexcept;
+
+    CYAsyncEvent(const CYAsyncEvent&) = delete;
+    CYAsyncEvent& operator=(const CYAsyncEvent&) = delete;
+
+public:
+    void                    Set() noexcept;
+    void                    Reset() noexcept;
+    bool                    IsSet() const noexcept;
+
+    CYAsyncEventAwaiter     Wait(SharePtr<CYExecutor> ptrResumeExecutor);
+
+    EAsyncEventMode         Mode() const noexcept;
+
+private:
+    const EAsyncEventMode   m_eMode;
+    CYAsyncWaitStack        m_stackWaiters;
+};
+
+CYCOROUTINE_NAMESPACE_END
+
+#endif //__CY_ASYNC_EVENT_CORO_HPP__
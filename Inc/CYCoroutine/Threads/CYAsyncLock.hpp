@@ -43,33 +43,63 @@
 #ifndef __CY_ASYNC_LOCK_CORO_HPP__
 #define __CY_ASYNC_LOCK_CORO_HPP__
 
-#include "CYCommon/Common/CYList.hpp"
-
 #include "CYCoroutine/CYCoroutineDefine.hpp"
 #include "CYCoroutine/Executors/CYExecutor.hpp"
 #include "CYCoroutine/Results/CYLazyResult.hpp"
+#include "CYCoroutine/Threads/CYCancellation.hpp"
+
+#include <atomic>
 
 CYCOROUTINE_NAMESPACE_BEGIN
 
+// Parked on the lock until a holder hands the lock over, the awaiter is then resumed
+// on its executor already owning the lock.
 class CAsyncLock;
 class CYCOROUTINE_API CAsyncLockAwaiter
 {
     friend class CAsyncLock;
+    friend class CAsyncLockTicket;
+    friend class CYAWaiter;
 public:
-    inline CAsyncLockAwaiter(CAsyncLock& parent, UniqueLock& lock) noexcept;
+    CAsyncLockAwaiter(CAsyncLock& parent, SharePtr<CYExecutor> ptrResumeExecutor) noexcept;
+    virtual ~CAsyncLockAwaiter() noexcept = default;
 
-    constexpr bool  await_ready() const noexcept;
-    void            await_suspend(coroutine_handle<void> hHandle);
-    constexpr void  await_resume() const noexcept;
-    void            retry() noexcept;
+    bool            await_ready() noexcept;
+    bool            await_suspend(coroutine_handle<void> hHandle) noexcept;
+    void            await_resume();
+
+    // false: the waiter gave up meanwhile (its wait was cancelled), the lock goes on to the next one.
+    virtual bool    Resume() noexcept;
 
 public:
     CAsyncLockAwaiter*      next = nullptr;
 
 private:
     CAsyncLock&             m_parent;
-    UniqueLock              m_lock;
+    SharePtr<CYExecutor>    m_ptrResumeExecutor;
     coroutine_handle<void>  m_handleResume;
+    bool                    m_bInterrupted = false;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Cancellable wait: the queued node is a CAsyncLockTicket on the heap, a cancelled waiter
+// leaves right away and the lock skips its ticket once it gets there.
+class CAsyncLockTicket;
+class CYCOROUTINE_API CAsyncLockCancellableAwaiter
+{
+public:
+    CAsyncLockCancellableAwaiter(CAsyncLock& parent, SharePtr<CYExecutor> ptrResumeExecutor, CYCancellationToken token) noexcept;
+
+    bool            await_ready() noexcept;
+    bool            await_suspend(coroutine_handle<void> hHandle);
+    void            await_resume();
+
+private:
+    CAsyncLock&             m_parent;
+    SharePtr<CYExecutor>    m_ptrResumeExecutor;
+    CYCancellationToken     m_token;
+    CAsyncLockTicket*       m_pTicket = nullptr;
+    bool                    m_bAcquired = false;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -78,20 +108,33 @@ class CYCOROUTINE_API CAsyncLock
 {
     friend class CScopedAsyncLock;
     friend class CAsyncLockAwaiter;
+    friend class CAsyncLockCancellableAwaiter;
+    friend class CYAWaiter;
 public:
     virtual ~CAsyncLock() noexcept;
 
     CYLazyResult<CScopedAsyncLock>  Lock(SharePtr<CYExecutor> ptrResumeExecutor);
+    // a cancelled wait leaves the waiter queue at once and fails with operation_canceled.
+    CYLazyResult<CScopedAsyncLock>  Lock(SharePtr<CYExecutor> ptrResumeExecutor, CYCancellationToken token);
     CYLazyResult<bool>              TryLock();
     void                            UnLock();
 
 private:
     CYLazyResult<CScopedAsyncLock>  LockImpl(SharePtr<CYExecutor> ptrResumeExecutor, bool bWithRAIIGuard);
+    CYLazyResult<CScopedAsyncLock>  LockImpl(SharePtr<CYExecutor> ptrResumeExecutor, CYCancellationToken token);
+
+    bool                            TryAcquire() noexcept;
+    bool                            Enqueue(CAsyncLockAwaiter& awaiter) noexcept;
+    void                            Release() noexcept;
+
+    static CAsyncLockAwaiter*       NotLockedConstant() noexcept;
 
 private:
-    bool                        m_bLocked = false;
-    std::mutex                  m_mutexAwaiter;
-    CYList<CAsyncLockAwaiter>   m_lstAwaiters;
+    // NotLockedConstant(), nullptr (locked, nobody waiting) or the newest waiter of a LIFO stack.
+    std::atomic<CAsyncLockAwaiter*> m_pState{ NotLockedConstant() };
+
+    // waiters taken off the stack in arrival order, only touched by the current holder.
+    CAsyncLockAwaiter*              m_pWaiters = nullptr;
 
 #ifdef CYCOROUTINE_DEBUG_MODE
     std::atomic_intptr_t        m_nThreadCountInCriticalSection{ 0 };
@@ -102,11 +145,11 @@ private:
 class CYCOROUTINE_API CScopedAsyncLock
 {
 public:
-    inline CScopedAsyncLock() noexcept = default;
-    inline CScopedAsyncLock(CScopedAsyncLock&& rhs) noexcept;
+    CScopedAsyncLock() noexcept = default;
+    CScopedAsyncLock(CScopedAsyncLock&& rhs) noexcept;
 
-    inline CScopedAsyncLock(CAsyncLock& lock, std::defer_lock_t) noexcept;
-    inline CScopedAsyncLock(CAsyncLock& lock, std::adopt_lock_t) noexcept;
+    CScopedAsyncLock(CAsyncLock& lock, std::defer_lock_t) noexcept;
+    CScopedAsyncLock(CAsyncLock& lock, std::adopt_lock_t) noexcept;
 
     virtual ~CScopedAsyncLock() noexcept;
 
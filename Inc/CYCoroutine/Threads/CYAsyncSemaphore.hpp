@@ -0,0 +1,117 @@
+/*
+ * CYCoroutine License
+ * -----------
+ *
+ * CYCoroutine is licensed under the terms of the MIT license reproduced below.
+ * This means that CYCoroutine is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+/*
+ * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ * VERSION:  1.0.0
+ * PURPOSE:  A cross-platform efficient and stable Coroutine library.
+ * CREATION: 2026.10.18
+ * LCHANGE:  2026.10.18
+ * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+ */
+
+#ifndef __CY_ASYNC_SEMAPHORE_CORO_HPP__
+#define __CY_ASYNC_SEMAPHORE_CORO_HPP__
+
+#include "CYCoroutine/CYCoroutineDefine.hpp"
+#include "CYCoroutine/Executors/CYExecutor.hpp"
+#include "CYCoroutine/Threads/CYAsyncWaitStack.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+class CYAsyncSemaphore;
+class CYCOROUTINE_API CYAsyncSemaphoreAwaiter : private CYAsyncWaitNode
+{
+    friend class CYAsyncSemaphore;
+public:
+    CYAsyncSemaphoreAwaiter(CYAsyncSemaphore& parent, size_t nCount, SharePtr<CYExecutor> ptrResumeExecutor) noexcept;
+
+    bool            await_ready() noexcept;
+    bool            await_suspend(coroutine_handle<void> hHandle);
+    void            await_resume();
+
+private:
+    CYAsyncSemaphore&           m_parent;
+    const size_t                m_nCount;
+};
+
+//////////////////////////////////////////////////////////////////////////
+/*
+ * Counting semaphore for coroutines: co_await Acquire(n, executor) suspends until n permits
+ * are available instead of blocking the worker. Acquire returns the awaiter itself, so it
+ * lives in the awaiting coroutine frame and nothing is allocated per acquisition. While
+ * nobody waits, acquiring and releasing is a CAS on the permit count; waiters are served
+ * strictly in FIFO order, a release hands the permits over to as many of them as it can
+ * and resumes them in batches on their executors.
+ */
+class CYCOROUTINE_API CYAsyncSemaphore
+{
+    friend class CYAsyncSemaphoreAwaiter;
+public:
+    explicit CYAsyncSemaphore(size_t nInitialCount) noexcept;
+    ~CYAsyncSemaphore() noexcept;
+
+    CYAsyncSemaphore(const CYAsyncSemaphore&) = delete;
+    CYAsyncSemaphore& operator=(const CYAsyncSemaphore&) = delete;
+
+public:
+    CYAsyncSemaphoreAwaiter     Acquire(size_t nCount, SharePtr<CYExecutor> ptrResumeExecutor);
+    bool                        TryAcquire(size_t nCount = 1) noexcept;
+    void                        Release(size_t nCount = 1);
+
+    size_t                      Available() const noexcept;
+
+private:
+    bool                        Enqueue(CYAsyncSemaphoreAwaiter& awaiter);
+    void                        HandOver(size_t nCount) noexcept;
+    static CYAsyncSemaphoreAwaiter* Next(const CYAsyncSemaphoreAwaiter& awaiter) noexcept;
+
+private:
+    static constexpr uint64_t k_nWaiters = 1;
+    static constexpr uint64_t k_nPermit = 2;
+
+    // permits * k_nPermit | k_nWaiters, k_nWaiters forces everybody onto the slow path.
+    std::atomic<uint64_t>       m_nState;
+
+    std::mutex                  m_mutexWaiters;
+    CYAsyncSemaphoreAwaiter*    m_pHead = nullptr;
+    CYAsyncSemaphoreAwaiter*    m_pTail = nullptr;
+};
+
+CYCOROUTINE_NAMESPACE_END
+
+#endif //__CY_ASYNC_SEMAPHORE_CORO_HPP__
@@ -0,0 +1,242 @@
+/*
+ * CYCoroutine License
+ * -----------
+ *
+ * CYCoroutine is licensed under the terms of the MIT license reproduced below.
+ * This means that CYCoroutine is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+/*
+ * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ * VERSION:  1.0.0
+ * PURPOSE:  A cross-platform efficient and stable Coroutine library.
+ * CREATION: 2026.10.18
+ * LCHANGE:  2026.10.18
+ * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+ */
+
+#ifndef __CY_ASYNC_SHARED_LOCK_CORO_HPP__
+#define __CY_ASYNC_SHARED_LOCK_CORO_HPP__
+
+#include "CYCommon/Common/CYList.hpp"
+
+#include "CYCoroutine/CYCoroutineDefine.hpp"
+#include "CYCoroutine/Executors/CYExecutor.hpp"
+#include "CYCoroutine/Results/CYLazyResult.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <system_error>
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+// Who gets the lock when a writer releases it while readers and writers are queued.
+enum class EAsyncSharedLockPolicy
+{
+    // the next writer, readers only get in once no writer is queued.
+    POLICY_WRITER_PREFERENCE,
+    // all queued readers, then the next writer: read and write phases alternate, nobody starves.
+    POLICY_PHASE_FAIR
+};
+
+class CYAsyncSharedLock;
+class CYCOROUTINE_API CYAsyncSharedLockAwaiter
+{
+    friend class CYAsyncSharedLock;
+public:
+    CYAsyncSharedLockAwaiter(CYAsyncSharedLock& parent, SharePtr<CYExecutor> ptrResumeExecutor, bool bShared) noexcept;
+
+    bool            await_ready() noexcept;
+    bool            await_suspend(coroutine_handle<void> hHandle);
+    void            await_resume();
+    void            Resume() noexcept;
+
+public:
+    CYAsyncSharedLockAwaiter*   next = nullptr;
+
+private:
+    CYAsyncSharedLock&          m_parent;
+    SharePtr<CYExecutor>        m_ptrResumeExecutor;
+    coroutine_handle<void>      m_handleResume;
+    const bool                  m_bShared;
+    bool                        m_bInterrupted = false;
+};
+
+//////////////////////////////////////////////////////////////////////////
+template<bool SHARED>
+class CYScopedAsyncSharedLockBase;
+
+using CYScopedAsyncSharedLock = CYScopedAsyncSharedLockBase<true>;
+using CYScopedAsyncUniqueLock = CYScopedAsyncSharedLockBase<false>;
+
+/*
+ * Reader-writer lock for coroutines. Uncontended shared and exclusive acquisition is a
+ * CAS on one atomic word holding the reader count and the writer bit, the mutex is only
+ * taken once somebody has to queue. Releasing hands the lock straight to the admitted
+ * waiters, each of them is posted once to its resume executor already owning it.
+ */
+class CYCOROUTINE_API CYAsyncSharedLock
+{
+    friend class CYAsyncSharedLockAwaiter;
+public:
+    CYAsyncSharedLock(EAsyncSharedLockPolicy ePolicy = EAsyncSharedLockPolicy::POLICY_WRITER_PREFERENCE) noexcept;
+    ~CYAsyncSharedLock() noexcept;
+
+    CYAsyncSharedLock(const CYAsyncSharedLock&) = delete;
+    CYAsyncSharedLock& operator=(const CYAsyncSharedLock&) = delete;
+
+public:
+    CYLazyResult<CYScopedAsyncSharedLock>   LockShared(SharePtr<CYExecutor> ptrResumeExecutor);
+    CYLazyResult<CYScopedAsyncUniqueLock>   Lock(SharePtr<CYExecutor> ptrResumeExecutor);
+
+    bool                                    TryLockShared() noexcept;
+    bool                                    TryLock() noexcept;
+
+    void                                    UnLockShared();
+    void                                    UnLock();
+
+    EAsyncSharedLockPolicy                  Policy() const noexcept;
+
+private:
+    CYLazyResult<CYScopedAsyncSharedLock>   LockSharedImpl(SharePtr<CYExecutor> ptrResumeExecutor);
+    CYLazyResult<CYScopedAsyncUniqueLock>   LockImpl(SharePtr<CYExecutor> ptrResumeExecutor);
+
+    bool                                    Enqueue(CYAsyncSharedLockAwaiter& awaiter);
+    void                                    Release(bool bShared) noexcept;
+    void                                    HandOver(bool bWriterReleased) noexcept;
+
+private:
+    static constexpr uint64_t k_nWriter = 1;
+    static constexpr uint64_t k_nWaiters = 2;
+    static constexpr uint64_t k_nReader = 4;
+
+    // reader count * k_nReader | k_nWriter | k_nWaiters, k_nWaiters forces everybody onto the slow path.
+    std::atomic<uint64_t>               m_nState{ 0 };
+    const EAsyncSharedLockPolicy        m_ePolicy;
+
+    std::mutex                          m_mutexWaiters;
+    CYList<CYAsyncSharedLockAwaiter>    m_lstReaders;
+    CYList<CYAsyncSharedLockAwaiter>    m_lstWriters;
+};
+
+//////////////////////////////////////////////////////////////////////////
+template<bool SHARED>
+class CYScopedAsyncSharedLockBase
+{
+public:
+    CYScopedAsyncSharedLockBase() noexcept = default;
+
+    CYScopedAsyncSharedLockBase(CYAsyncSharedLock& lock, std::adopt_lock_t) noexcept
+        : m_pLock(&lock)
+    {
+    }
+
+    CYScopedAsyncSharedLockBase(CYScopedAsyncSharedLockBase&& rhs) noexcept
+        : m_pLock(std::exchange(rhs.m_pLock, nullptr))
+    {
+    }
+
+    CYScopedAsyncSharedLockBase& operator=(CYScopedAsyncSharedLockBase&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            Reset();
+            m_pLock = std::exchange(rhs.m_pLock, nullptr);
+        }
+
+        return *this;
+    }
+
+    ~CYScopedAsyncSharedLockBase() noexcept
+    {
+        Reset();
+    }
+
+public:
+    void UnLock()
+    {
+        if (m_pLock == nullptr)
+        {
+            throw std::system_error(static_cast<int>(std::errc::operation_not_permitted), std::system_category(), "CYScopedAsyncSharedLock::UnLock() - trying to unlock an unowned lock.");
+        }
+
+        Reset();
+    }
+
+    bool OwnsLock() const noexcept
+    {
+        return m_pLock != nullptr;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return OwnsLock();
+    }
+
+    void Swap(CYScopedAsyncSharedLockBase& rhs) noexcept
+    {
+        std::swap(m_pLock, rhs.m_pLock);
+    }
+
+    CYAsyncSharedLock* Release() noexcept
+    {
+        return std::exchange(m_pLock, nullptr);
+    }
+
+    CYAsyncSharedLock* Mutex() const noexcept
+    {
+        return m_pLock;
+    }
+
+private:
+    void Reset() noexcept
+    {
+        const auto pLock = std::exchange(m_pLock, nullptr);
+        if (pLock == nullptr)
+        {
+            return;
+        }
+
+        if constexpr (SHARED)
+        {
+            pLock->UnLockShared();
+        }
+        else
+        {
+            pLock->UnLock();
+        }
+    }
+
+private:
+    CYAsyncSharedLock* m_pLock = nullptr;
+};
+
+CYCOROUTINE_NAMESPACE_END
+
+#endif //__CY_ASYNC_SHARED_LOCK_CORO_HPP__
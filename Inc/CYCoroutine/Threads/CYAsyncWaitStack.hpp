@@ -0,0 +1,132 @@
+/*
+ * CYCoroutine License
+ * -----------
+ *
+ * CYCoroutine is licensed under the terms of the MIT license reproduced below.
+ * This means that CYCoroutine is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+/*
+ * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ * VERSION:  1.0.0
+ * PURPOSE:  A cross-platform efficient and stable Coroutine library.
+ * CREATION: 2026.10.18
+ * LCHANGE:  2026.10.18
+ * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+ */
+
+#ifndef __CY_ASYNC_WAIT_STACK_CORO_HPP__
+#define __CY_ASYNC_WAIT_STACK_CORO_HPP__
+
+#include "CYCoroutine/CYCoroutineDefine.hpp"
+#include "CYCoroutine/Executors/CYExecutor.hpp"
+
+#include <atomic>
+#include <mutex>
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+// Waiter of a CYAsyncWaitStack, embedded in the awaiter that lives in the suspended frame.
+class CYCOROUTINE_API CYAsyncWaitNode
+{
+    friend class CYAsyncWaitStack;
+public:
+    explicit CYAsyncWaitNode(SharePtr<CYExecutor> ptrResumeExecutor) noexcept;
+
+    void            SetCaller(coroutine_handle<void> handleCaller) noexcept;
+    bool            Interrupted() const noexcept;
+
+public:
+    CYAsyncWaitNode*        next = nullptr;
+
+private:
+    SharePtr<CYExecutor>    m_ptrResumeExecutor;
+    coroutine_handle<void>  m_handleResume;
+    bool                    m_bInterrupted = false;
+};
+
+//////////////////////////////////////////////////////////////////////////
+/*
+ * Lock-free intrusive stack of waiting coroutines with a signaled state, the building block
+ * of CYAsyncLatch, CYAsyncBarrier and CYAsyncEvent. Pushing is a CAS on the head, signaling
+ * takes the whole stack and resumes the waiters in arrival order on their executors, waiters
+ * resuming on the same executor are enqueued together.
+ */
+class CYCOROUTINE_API CYAsyncWaitStack
+{
+public:
+    explicit CYAsyncWaitStack(bool bSignaled = false) noexcept;
+    ~CYAsyncWaitStack() noexcept;
+
+    CYAsyncWaitStack(const CYAsyncWaitStack&) = delete;
+    CYAsyncWaitStack& operator=(const CYAsyncWaitStack&) = delete;
+
+public:
+    bool                    Signaled() const noexcept;
+
+    // false: already signaled, the caller goes on without suspending.
+    bool                    Push(CYAsyncWaitNode& node) noexcept;
+    // like Push(), but a signaled stack is reset on the way, the signal is consumed.
+    bool                    PushOrConsume(CYAsyncWaitNode& node) noexcept;
+
+    // signals the stack and resumes everybody waiting.
+    void                    Signal() noexcept;
+    // resumes the oldest waiter, or leaves the stack signaled if nobody waits. Waiters taken off
+    // the stack wait in a FIFO that is served before the stack, so each call is O(1) amortized.
+    // Not to be mixed with Signal() on the same stack.
+    void                    SignalOne() noexcept;
+    // signaled -> not signaled, false if it wasn't signaled.
+    bool                    Reset() noexcept;
+
+    // takes the waiters off a stack that is never signaled, newest first.
+    CYAsyncWaitNode*        TakeAll() noexcept;
+    static void             ResumeAll(CYAsyncWaitNode* pStack) noexcept;
+    // resumes a chain of waiters linked oldest first, consecutive ones resuming on the same
+    // executor are enqueued together.
+    static void             ResumeInOrder(CYAsyncWaitNode* pNode) noexcept;
+
+private:
+    static CYAsyncWaitNode* SignaledConstant() noexcept;
+    // moves the stack into the empty FIFO, or signals the stack if nobody waits. Under m_mutexReady.
+    bool                    TakeReady() noexcept;
+    static void             Resume(CYAsyncWaitNode& node) noexcept;
+
+private:
+    static constexpr size_t k_nResumeBatch = 16;
+
+    // nullptr, SignaledConstant() or the newest waiter.
+    std::atomic<CYAsyncWaitNode*>   m_pHead;
+
+    // SignalOne() only: waiters already taken off the stack, oldest first.
+    std::mutex                      m_mutexReady;
+    CYAsyncWaitNode*                m_pReady = nullptr;
+};
+
+CYCOROUTINE_NAMESPACE_END
+
+#endif //__CY_ASYNC_WAIT_STACK_CORO_HPP__
@@ -0,0 +1,149 @@
+/*
+ * CYCoroutine License
+ * -----------
+ *
+ * CYCoroutine is licensed under the terms of the MIT license reproduced below.
+ * This means that CYCoroutine is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+/*
+ * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ * VERSION:  1.0.0
+ * PURPOSE:  A cross-platform efficient and stable Coroutine library.
+ * CREATION: 2026.10.18
+ * LCHANGE:  2026.10.18
+ * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+ */
+
+#ifndef __CY_CANCELLATION_CORO_HPP__
+#define __CY_CANCELLATION_CORO_HPP__
+
+#include "CYCoroutine/CYCoroutineDefine.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+//////////////////////////////////////////////////////////////////////////
+// Registered with a CYCancellationToken, OnCancel() runs once on the thread that cancels.
+class CYCOROUTINE_API CYCancellationCallback
+{
+    friend class CYCancellationState;
+public:
+    virtual ~CYCancellationCallback() noexcept = default;
+
+    virtual void OnCancel() noexcept = 0;
+
+private:
+    CYCancellationCallback*     m_pPrev = nullptr;
+    CYCancellationCallback*     m_pNext = nullptr;
+    bool                        m_bRegistered = false;
+    bool*                       m_pbDeregistered = nullptr;
+    std::atomic_bool            m_bDone{ false };
+};
+
+//////////////////////////////////////////////////////////////////////////
+class CYCOROUTINE_API CYCancellationState
+{
+public:
+    CYCancellationState() noexcept = default;
+    ~CYCancellationState() noexcept;
+
+    CYCancellationState(const CYCancellationState&) = delete;
+    CYCancellationState& operator=(const CYCancellationState&) = delete;
+
+public:
+    bool            Cancelled() const noexcept;
+    bool            Cancel() noexcept;
+
+    // false: already cancelled, the callback is not registered and won't run.
+    bool            Register(CYCancellationCallback& callback) noexcept;
+    // once this returns the callback is not running and won't run anymore, called from
+    // inside its own OnCancel() it returns right away.
+    void            Deregister(CYCancellationCallback& callback) noexcept;
+
+private:
+    std::atomic_bool            m_bCancelled{ false };
+
+    std::mutex                  m_lock;
+    CYCancellationCallback*     m_pHead = nullptr;
+    CYCancellationCallback*     m_pRunning = nullptr;
+    std::thread::id             m_idCanceller;
+};
+
+//////////////////////////////////////////////////////////////////////////
+/*
+ * Observing side of a CYCancellationSource, cheap to copy and pass down into Submit(),
+ * MakeDelayObject(), CAsyncLock::Lock(), CYAsyncCondition::await() and WithCancellation().
+ * Operations waiting on a cancelled token are taken out of their queues right away and fail
+ * with std::system_error(std::errc::operation_canceled). A default constructed token never
+ * gets cancelled.
+ */
+class CYCOROUTINE_API CYCancellationToken
+{
+    friend class CYCancellationSource;
+public:
+    CYCancellationToken() noexcept = default;
+
+public:
+    bool            IsCancelled() const noexcept;
+    bool            CanBeCancelled() const noexcept;
+    void            ThrowIfCancelled() const;
+
+    bool            Register(CYCancellationCallback& callback) const noexcept;
+    void            Deregister(CYCancellationCallback& callback) const noexcept;
+
+private:
+    explicit CYCancellationToken(SharePtr<CYCancellationState> ptrState) noexcept;
+
+private:
+    SharePtr<CYCancellationState> m_ptrState;
+};
+
+//////////////////////////////////////////////////////////////////////////
+class CYCOROUTINE_API CYCancellationSource
+{
+public:
+    CYCancellationSource();
+
+public:
+    CYCancellationToken     Token() const noexcept;
+
+    // runs the registered callbacks on the calling thread, true for the first call only.
+    bool                    Cancel() noexcept;
+    bool                    IsCancelled() const noexcept;
+
+private:
+    SharePtr<CYCancellationState> m_ptrState;
+};
+
+CYCOROUTINE_NAMESPACE_END
+
+#endif //__CY_CANCELLATION_CORO_HPP__
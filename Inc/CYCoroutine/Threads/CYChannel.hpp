@@ -0,0 +1,717 @@
+/*
+ * CYCoroutine License
+ * -----------
+ *
+ * CYCoroutine is licensed under the terms of the MIT license reproduced below.
+ * This means that CYCoroutine is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+/*
+ * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ * VERSION:  1.0.0
+ * PURPOSE:  A cross-platform efficient and stable Coroutine library.
+ * CREATION: 2026.10.18
+ * LCHANGE:  2026.10.18
+ * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+ */
+
+#ifndef __CY_CHANNEL_CORO_HPP__
+#define __CY_CHANNEL_CORO_HPP__
+
+#include "CYCoroutine/CYCoroutineDefine.hpp"
+#include "CYCoroutine/Executors/CYExecutor.hpp"
+#include "CYCoroutine/Results/Impl/CYConsumerContext.hpp"
+#include "CYCoroutine/Threads/CYCacheLine.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <span>
+#include <type_traits>
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+//////////////////////////////////////////////////////////////////////////
+// Bounded lock-free MPMC ring: every slot carries a sequence number telling producers and
+// consumers whose turn it is, so neither side takes a lock. The ring is a power of two >= 2, a
+// smaller requested capacity is enforced by checking the producer position against the consumer's.
+template<class TYPE>
+class CYBoundedQueue
+{
+public:
+    explicit CYBoundedQueue(size_t nCapacity)
+        : m_nCapacity(nCapacity)
+        , m_nMask(RoundUp(nCapacity) - 1)
+        , m_ptrSlots(MakeUnique<CYSlot[]>(m_nMask + 1))
+    {
+        for (size_t i = 0; i <= m_nMask; i++)
+        {
+            m_ptrSlots[i].nSequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~CYBoundedQueue() noexcept
+    {
+        while (TryPop().has_value())
+        {
+        }
+    }
+
+    size_t Capacity() const noexcept
+    {
+        return m_nCapacity;
+    }
+
+    // value is moved from only if it was pushed.
+    bool TryPush(TYPE& value) noexcept
+    {
+        auto nPos = m_nEnqueuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            auto& objSlot = m_ptrSlots[nPos & m_nMask];
+            const auto nSequence = objSlot.nSequence.load(std::memory_order_acquire);
+            const auto nDiff = static_cast<intptr_t>(nSequence) - static_cast<intptr_t>(nPos);
+
+            if (nDiff == 0)
+            {
+                if (m_nCapacity <= m_nMask && IsFull(nPos))
+                {
+                    return false;
+                }
+
+                if (m_nEnqueuePos.compare_exchange_weak(nPos, nPos + 1, std::memory_order_relaxed))
+                {
+                    new (objSlot.storage) TYPE(std::move(value));
+                    objSlot.nSequence.store(nPos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (nDiff < 0)
+            {
+                return false;  // full
+            }
+            else
+            {
+                nPos = m_nEnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::optional<TYPE> TryPop() noexcept
+    {
+        auto nPos = m_nDequeuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            auto& objSlot = m_ptrSlots[nPos & m_nMask];
+            const auto nSequence = objSlot.nSequence.load(std::memory_order_acquire);
+            const auto nDiff = static_cast<intptr_t>(nSequence) - static_cast<intptr_t>(nPos + 1);
+
+            if (nDiff == 0)
+            {
+                if (m_nDequeuePos.compare_exchange_weak(nPos, nPos + 1, std::memory_order_relaxed))
+                {
+                    auto pValue = std::launder(reinterpret_cast<TYPE*>(objSlot.storage));
+                    std::optional<TYPE> value(std::move(*pValue));
+                    pValue->~TYPE();
+                    objSlot.nSequence.store(nPos + m_nMask + 1, std::memory_order_release);
+                    return value;
+                }
+            }
+            else if (nDiff < 0)
+            {
+                return std::nullopt;  // empty
+            }
+            else
+            {
+                nPos = m_nDequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct CYSlot
+    {
+        std::atomic_size_t nSequence{ 0 };
+        alignas(TYPE) unsigned char storage[sizeof(TYPE)];
+    };
+
+    // a stale consumer position only makes the queue look full, the callers retry after their fence.
+    bool IsFull(size_t nPos) const noexcept
+    {
+        const auto nDequeuePos = m_nDequeuePos.load(std::memory_order_acquire);
+        return static_cast<intptr_t>(nPos - nDequeuePos) >= static_cast<intptr_t>(m_nCapacity);
+    }
+
+    static size_t RoundUp(size_t nCapacity) noexcept
+    {
+        size_t nSize = 2;
+        while (nSize < nCapacity)
+        {
+            nSize <<= 1;
+        }
+
+        return nSize;
+    }
+
+private:
+    const size_t m_nCapacity;
+    const size_t m_nMask;
+    UniquePtr<CYSlot[]> m_ptrSlots;
+    alignas(CACHE_LINE_ALIGNMENT) std::atomic_size_t m_nEnqueuePos{ 0 };
+    alignas(CACHE_LINE_ALIGNMENT) std::atomic_size_t m_nDequeuePos{ 0 };
+};
+
+//////////////////////////////////////////////////////////////////////////
+/*
+ * Bounded multi-producer/multi-consumer channel between coroutines.
+ * Send/Receive go through the lock-free ring and only fall back to the waiter lists when the
+ * ring is full/empty. A parked coroutine is handed its value by whoever makes room or data
+ * and is resumed on that thread, or posted to the resume executor it passed in (a task dropped
+ * by that executor resumes the coroutine inline). Close() wakes everybody: pending Send()s
+ * return false, Receive() keeps draining what is buffered and then returns nothing.
+ */
+template<class TYPE>
+class CYChannel
+{
+    static_assert(std::is_nothrow_move_constructible_v<TYPE>, "CYChannel<TYPE> - <<TYPE>> should be no-throw-move constructible.");
+
+    //////////////////////////////////////////////////////////////////////////
+    struct CYWaiter
+    {
+        CYWaiter* next = nullptr;
+        coroutine_handle<void> handleCaller;
+        SharePtr<CYExecutor> ptrResumeExecutor;
+        bool bInterrupted = false;
+
+        void Resume() noexcept
+        {
+            assert(static_cast<bool>(handleCaller));
+            if (!static_cast<bool>(ptrResumeExecutor))
+            {
+                return handleCaller();
+            }
+
+            auto ptrExecutor = std::move(ptrResumeExecutor);
+
+            try
+            {
+                ptrExecutor->Post(CYAwaitViaFunctor{ handleCaller, &bInterrupted });
+            }
+            catch (...)
+            {
+                // do nothing. ~CYAwaitViaFunctor resumes the coroutine inline.
+            }
+        }
+    };
+
+    template<class WAITER_TYPE>
+    struct CYWaiterQueue
+    {
+        WAITER_TYPE* pHead = nullptr;
+        WAITER_TYPE* pTail = nullptr;
+
+        WAITER_TYPE* Front() const noexcept
+        {
+            return pHead;
+        }
+
+        void PushBack(WAITER_TYPE& objWaiter) noexcept
+        {
+            objWaiter.next = nullptr;
+            if (pTail == nullptr)
+            {
+                pHead = pTail = &objWaiter;
+                return;
+            }
+
+            pTail->next = &objWaiter;
+            pTail = &objWaiter;
+        }
+
+        WAITER_TYPE* PopFront() noexcept
+        {
+            auto pWaiter = pHead;
+            if (pWaiter != nullptr)
+            {
+                pHead = static_cast<WAITER_TYPE*>(pWaiter->next);
+                if (pHead == nullptr)
+                {
+                    pTail = nullptr;
+                }
+            }
+
+            return pWaiter;
+        }
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    class CYSendAwaitable : public CYWaiter
+    {
+        friend class CYChannel;
+    public:
+        CYSendAwaitable(CYChannel& parent, TYPE&& value, SharePtr<CYExecutor>&& ptrResumeExecutor) noexcept
+            : m_parent(parent)
+            , m_value(std::move(value))
+        {
+            this->ptrResumeExecutor = std::move(ptrResumeExecutor);
+        }
+
+        bool await_ready() noexcept
+        {
+            if (m_parent.IsClosed())
+            {
+                return true;
+            }
+
+            m_bSent = m_parent.m_objQueue.TryPush(m_value);
+            if (m_bSent)
+            {
+                m_parent.OnPushed();
+            }
+
+            return m_bSent;
+        }
+
+        bool await_suspend(coroutine_handle<void> handleCaller) noexcept
+        {
+            return m_parent.SuspendSender(*this, handleCaller);
+        }
+
+        bool await_resume() const noexcept
+        {
+            return m_bSent;
+        }
+
+    private:
+        CYSendAwaitable(const CYSendAwaitable&) = delete;
+        CYSendAwaitable(CYSendAwaitable&&) = delete;
+
+    private:
+        CYChannel& m_parent;
+        TYPE m_value;
+        bool m_bSent = false;
+    };
+
+    class CYReceiveWaiter : public CYWaiter
+    {
+        friend class CYChannel;
+    public:
+        CYReceiveWaiter(CYChannel& parent, std::span<TYPE> lstOut, bool bBatch, SharePtr<CYExecutor>&& ptrResumeExecutor) noexcept
+            : m_parent(parent)
+            , m_lstOut(lstOut)
+            , m_bBatch(bBatch)
+        {
+            this->ptrResumeExecutor = std::move(ptrResumeExecutor);
+        }
+
+        bool await_ready() noexcept
+        {
+            if (m_bBatch && m_lstOut.empty())
+            {
+                return true;
+            }
+
+            if (Fill(m_parent.m_objQueue))
+            {
+                m_parent.OnPopped();
+                return true;
+            }
+
+            if (!m_parent.IsClosed())
+            {
+                return false;
+            }
+
+            // closed: whatever made it in before Close() is still handed out
+            if (Fill(m_parent.m_objQueue))
+            {
+                m_parent.OnPopped();
+            }
+
+            return true;
+        }
+
+        bool await_suspend(coroutine_handle<void> handleCaller) noexcept
+        {
+            return m_parent.SuspendReceiver(*this, handleCaller);
+        }
+
+    protected:
+        // pops into the waiter, false if the ring had nothing
+        bool Fill(CYBoundedQueue<TYPE>& objQueue) noexcept
+        {
+            if (!m_bBatch)
+            {
+                m_value = objQueue.TryPop();
+                return m_value.has_value();
+            }
+
+            m_nReceived = PopInto(objQueue, m_lstOut);
+            return m_nReceived != 0;
+        }
+
+    private:
+        CYReceiveWaiter(const CYReceiveWaiter&) = delete;
+        CYReceiveWaiter(CYReceiveWaiter&&) = delete;
+
+    protected:
+        CYChannel& m_parent;
+        std::optional<TYPE> m_value;
+        std::span<TYPE> m_lstOut;
+        size_t m_nReceived = 0;
+        bool m_bBatch;
+    };
+
+    class CYReceiveAwaitable : public CYReceiveWaiter
+    {
+    public:
+        CYReceiveAwaitable(CYChannel& parent, SharePtr<CYExecutor>&& ptrResumeExecutor) noexcept
+            : CYReceiveWaiter(parent, {}, false, std::move(ptrResumeExecutor))
+        {
+        }
+
+        std::optional<TYPE> await_resume() noexcept
+        {
+            return std::move(this->m_value);
+        }
+    };
+
+    class CYReceiveBatchAwaitable : public CYReceiveWaiter
+    {
+    public:
+        CYReceiveBatchAwaitable(CYChannel& parent, std::span<TYPE> lstOut, SharePtr<CYExecutor>&& ptrResumeExecutor) noexcept
+            : CYReceiveWaiter(parent, lstOut, true, std::move(ptrResumeExecutor))
+        {
+        }
+
+        size_t await_resume() const noexcept
+        {
+            return this->m_nReceived;
+        }
+    };
+
+public:
+    explicit CYChannel(size_t nCapacity)
+        : m_objQueue(ValidCapacity(nCapacity))
+    {
+    }
+
+    ~CYChannel() noexcept
+    {
+        assert(m_lstSenders.Front() == nullptr && m_lstReceivers.Front() == nullptr && "CYChannel is destroyed while being awaited.");
+    }
+
+public:
+    bool TrySend(TYPE&& value)
+    {
+        if (IsClosed() || !m_objQueue.TryPush(value))
+        {
+            return false;
+        }
+
+        OnPushed();
+        return true;
+    }
+
+    bool TrySend(const TYPE& value)
+    {
+        TYPE copy(value);
+        return TrySend(std::move(copy));
+    }
+
+    std::optional<TYPE> TryReceive()
+    {
+        auto value = m_objQueue.TryPop();
+        if (value.has_value())
+        {
+            OnPopped();
+        }
+
+        return value;
+    }
+
+    size_t TryReceive(std::span<TYPE> lstOut)
+    {
+        const auto nReceived = PopInto(m_objQueue, lstOut);
+        if (nReceived != 0)
+        {
+            OnPopped();
+        }
+
+        return nReceived;
+    }
+
+    // co_await Send(v) -> false if the channel was closed, v is dropped then.
+    CYSendAwaitable Send(TYPE value, SharePtr<CYExecutor> ptrResumeExecutor = {})
+    {
+        return CYSendAwaitable(*this, std::move(value), std::move(ptrResumeExecutor));
+    }
+
+    // co_await Receive() -> empty once the channel is closed and drained.
+    CYReceiveAwaitable Receive(SharePtr<CYExecutor> ptrResumeExecutor = {})
+    {
+        return CYReceiveAwaitable(*this, std::move(ptrResumeExecutor));
+    }
+
+    // co_await Receive(span) -> number of values moved into span, waits for at least one, 0 once closed and drained.
+    CYReceiveBatchAwaitable Receive(std::span<TYPE> lstOut, SharePtr<CYExecutor> ptrResumeExecutor = {})
+    {
+        return CYReceiveBatchAwaitable(*this, lstOut, std::move(ptrResumeExecutor));
+    }
+
+    void Close()
+    {
+        CYWaiterQueue<CYWaiter> lstReady;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutexWaiters);
+            if (m_bClosed.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+
+            m_bClosed.store(true, std::memory_order_release);
+            DrainLocked(lstReady);
+
+            while (auto pReceiver = m_lstReceivers.PopFront())
+            {
+                m_nReceiversWaiting.fetch_sub(1, std::memory_order_relaxed);
+                lstReady.PushBack(*pReceiver);
+            }
+
+            while (auto pSender = m_lstSenders.PopFront())
+            {
+                m_nSendersWaiting.fetch_sub(1, std::memory_order_relaxed);
+                lstReady.PushBack(*pSender);
+            }
+        }
+
+        Resume(lstReady);
+    }
+
+    bool IsClosed() const noexcept
+    {
+        return m_bClosed.load(std::memory_order_acquire);
+    }
+
+    size_t Capacity() const noexcept
+    {
+        return m_objQueue.Capacity();
+    }
+
+private:
+    CYChannel(const CYChannel&) = delete;
+    CYChannel& operator=(const CYChannel&) = delete;
+
+    static size_t ValidCapacity(size_t nCapacity)
+    {
+        if (nCapacity == 0)
+        {
+            throw std::invalid_argument("CYChannel - capacity must be positive.");
+        }
+
+        return nCapacity;
+    }
+
+    static size_t PopInto(CYBoundedQueue<TYPE>& objQueue, std::span<TYPE> lstOut) noexcept
+    {
+        size_t nReceived = 0;
+        while (nReceived < lstOut.size())
+        {
+            auto value = objQueue.TryPop();
+            if (!value.has_value())
+            {
+                break;
+            }
+
+            lstOut[nReceived++] = std::move(*value);
+        }
+
+        return nReceived;
+    }
+
+    /*
+     * A waiter bumps its counter under the lock and then retries the ring, the fast path updates the
+     * ring and then reads the counter, each side with a full fence in between: either the waiter sees
+     * the new value/room or the fast path sees the waiter and drains the lists.
+     */
+    void OnPushed()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_nReceiversWaiting.load(std::memory_order_relaxed) != 0)
+        {
+            Wake();
+        }
+    }
+
+    void OnPopped()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_nSendersWaiting.load(std::memory_order_relaxed) != 0)
+        {
+            Wake();
+        }
+    }
+
+    void Wake()
+    {
+        CYWaiterQueue<CYWaiter> lstReady;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutexWaiters);
+            DrainLocked(lstReady);
+        }
+
+        Resume(lstReady);
+    }
+
+    // moves values between the ring and the parked coroutines until neither side can progress.
+    void DrainLocked(CYWaiterQueue<CYWaiter>& lstReady) noexcept
+    {
+        while (true)
+        {
+            auto bProgress = false;
+
+            while (auto pReceiver = m_lstReceivers.Front())
+            {
+                if (!pReceiver->Fill(m_objQueue))
+                {
+                    break;
+                }
+
+                m_lstReceivers.PopFront();
+                m_nReceiversWaiting.fetch_sub(1, std::memory_order_relaxed);
+                lstReady.PushBack(*pReceiver);
+                bProgress = true;
+            }
+
+            while (auto pSender = m_lstSenders.Front())
+            {
+                if (!m_objQueue.TryPush(pSender->m_value))
+                {
+                    break;
+                }
+
+                pSender->m_bSent = true;
+                m_lstSenders.PopFront();
+                m_nSendersWaiting.fetch_sub(1, std::memory_order_relaxed);
+                lstReady.PushBack(*pSender);
+                bProgress = true;
+            }
+
+            if (!bProgress)
+            {
+                break;
+            }
+        }
+    }
+
+    static void Resume(CYWaiterQueue<CYWaiter>& lstReady) noexcept
+    {
+        while (auto pWaiter = lstReady.PopFront())
+        {
+            pWaiter->Resume();
+        }
+    }
+
+    bool SuspendSender(CYSendAwaitable& objSender, coroutine_handle<void> handleCaller) noexcept
+    {
+        CYWaiterQueue<CYWaiter> lstReady;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutexWaiters);
+            if (m_bClosed.load(std::memory_order_relaxed))
+            {
+                return false;
+            }
+
+            m_nSendersWaiting.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (!m_objQueue.TryPush(objSender.m_value))
+            {
+                objSender.handleCaller = handleCaller;
+                m_lstSenders.PushBack(objSender);
+                return true;
+            }
+
+            m_nSendersWaiting.fetch_sub(1, std::memory_order_relaxed);
+            objSender.m_bSent = true;
+            DrainLocked(lstReady);
+        }
+
+        Resume(lstReady);
+        return false;
+    }
+
+    bool SuspendReceiver(CYReceiveWaiter& objReceiver, coroutine_handle<void> handleCaller) noexcept
+    {
+        CYWaiterQueue<CYWaiter> lstReady;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutexWaiters);
+            m_nReceiversWaiting.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (!objReceiver.Fill(m_objQueue))
+            {
+                if (!m_bClosed.load(std::memory_order_relaxed))
+                {
+                    objReceiver.handleCaller = handleCaller;
+                    m_lstReceivers.PushBack(objReceiver);
+                    return true;
+                }
+
+                m_nReceiversWaiting.fetch_sub(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            m_nReceiversWaiting.fetch_sub(1, std::memory_order_relaxed);
+            DrainLocked(lstReady);
+        }
+
+        Resume(lstReady);
+        return false;
+    }
+
+private:
+    CYBoundedQueue<TYPE> m_objQueue;
+    std::atomic_bool m_bClosed{ false };
+    alignas(CACHE_LINE_ALIGNMENT) std::atomic_size_t m_nSendersWaiting{ 0 };
+    std::atomic_size_t m_nReceiversWaiting{ 0 };
+    std::mutex m_mutexWaiters;
+    CYWaiterQueue<CYSendAwaitable> m_lstSenders;
+    CYWaiterQueue<CYReceiveWaiter> m_lstReceivers;
+};
+
+CYCOROUTINE_NAMESPACE_END
+
+#endif //__CY_CHANNEL_CORO_HPP__
@@ -47,6 +47,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <memory>
 
 CYCOROUTINE_NAMESPACE_BEGIN
@@ -118,6 +119,29 @@ public:
         return m_bCancelled.load(std::memory_order_relaxed);
     }
 
+    // set once before the timer is published, a worker-local timer is cancelled through its pool.
+    inline size_t GetLocalWorker() const noexcept
+    {
+        return m_nLocalWorker;
+    }
+
+    inline void SetLocalWorker(size_t nWorkerIndex) noexcept
+    {
+        m_nLocalWorker = nWorkerIndex;
+    }
+
+public:
+    // links of the timing wheel backend, only touched by the timer queue thread.
+    struct CYWheelHook
+    {
+        CYTimerStateBase* pPrev = nullptr;
+        CYTimerStateBase* pNext = nullptr;
+        uint32_t nSlot = UINT32_MAX;
+
+        // the wheel's reference while the timer is linked.
+        SharePtr<CYTimerStateBase> ptrSelf;
+    } objWheelHook;
+
 private:
     inline static TimePoint MakeDeadLine(milliseconds nDiff) noexcept
     {
@@ -131,6 +155,7 @@ private:
     TimePoint m_tpDeadLine;
     std::atomic_bool m_bCancelled;
     std::atomic_size_t m_nFrequency;
+    size_t m_nLocalWorker = static_cast<size_t>(-1);
 
     const SharePtr<CYExecutor> m_ptrExecutor;
     const WeakPtr<CYTimerQueue> m_ptrTimerQueue;
@@ -159,6 +184,11 @@ public:
         m_callable();
     }
 
+    CALLABLE_TYPE& Callable() noexcept
+    {
+        return m_callable;
+    }
+
 private:
     CALLABLE_TYPE m_callable;
 };
@@ -48,6 +48,7 @@
 
 #include "CYCoroutine/CYCoroutineDefine.hpp"
 #include "CYCoroutine/Results/CYLazyResult.hpp"
+#include "CYCoroutine/Threads/CYCancellation.hpp"
 #include "CYCoroutine/Threads/CYThread.hpp"
 #include "CYTimer.hpp"
 
@@ -74,16 +75,24 @@ using milliseconds = std::chrono::milliseconds;
 class CYCOROUTINE_API CYTimerQueue : public std::enable_shared_from_this<CYTimerQueue>
 {
     friend class CYTimer;
+    friend class CYSelectTimerCase;
 public:
-    CYTimerQueue(milliseconds nMaxWaitTime, const FuncThreadDelegate& funThreadStartedCallback = {}, const FuncThreadDelegate& funThreadTerminatedCallback = {});
+    CYTimerQueue(milliseconds nMaxWaitTime, const FuncThreadDelegate& funThreadStartedCallback = {}, const FuncThreadDelegate& funThreadTerminatedCallback = {}, ETimerQueueBackend eBackend = ETimerQueueBackend::BACKEND_TIMER_SET, bool bWorkerLocalTimers = false);
     ~CYTimerQueue() noexcept;
 
 public:
     void ShutDown();
     bool ShutdownRequested() const noexcept;
+    // changes whenever any timer queue is shut down.
+    static size_t ShutdownEpoch() noexcept;
 
     milliseconds MaxWorkerIdleTime() const noexcept;
+    ETimerQueueBackend Backend() const noexcept;
+    // timers made on a thread pool worker for its own pool stay on that worker, see AddWorkerLocalTimer().
+    bool WorkerLocalTimers() const noexcept;
     CYLazyResult<void> MakeDelayObject(milliseconds nDueTime, SharePtr<CYExecutor> ptrExecutor);
+    // a cancel removes the timer from the queue and fails the delay with operation_canceled on ptrExecutor.
+    CYLazyResult<void> MakeDelayObject(milliseconds nDueTime, SharePtr<CYExecutor> ptrExecutor, CYCancellationToken token);
 
 public:
     template<class CALLABLE_TYPE, class... ARGS_TYPES>
@@ -115,8 +124,10 @@ private:
     void RemoveInternalTimer(TimerPtr ptrExistTimer);
 
     void AddTimer(UniqueLock& lock, TimerPtr ptrNewTimer);
+    bool AddWorkerLocalTimer(const TimerPtr& ptrNewTimer);
 
     CYLazyResult<void> MakeDelayObjectImpl(milliseconds nDueTime, SharePtr<CYTimerQueue> ptrSelf, SharePtr<CYExecutor> ptrExecutor);
+    CYLazyResult<void> MakeDelayObjectImpl(milliseconds nDueTime, SharePtr<CYTimerQueue> ptrSelf, SharePtr<CYExecutor> ptrExecutor, CYCancellationToken token);
 
     template<class CALLABLE_TYPE>
     TimerPtr MakeTimerImpl(size_t nDueTime, size_t nFrequency, SharePtr<CYExecutor> ptrExecutor, bool isOneShot, CALLABLE_TYPE&& callable)
@@ -125,6 +136,11 @@ private:
 
         using DecayedType = typename std::decay_t<CALLABLE_TYPE>;
         auto timerState = MakeShared<CYTimerState<DecayedType>>(nDueTime, nFrequency, std::move(ptrExecutor), weak_from_this(), isOneShot, std::forward<CALLABLE_TYPE>(callable));
+        if (AddWorkerLocalTimer(timerState))
+        {
+            return timerState;
+        }
+
         {
             UniqueLock lock(m_lock);
             AddTimer(lock, timerState);
@@ -135,6 +151,9 @@ private:
 
     void WorkLoop();
 
+    template<class INTERNAL_TYPE>
+    void WorkLoopImpl(INTERNAL_TYPE& objInternal);
+
 private:
     std::atomic_bool m_bAtomicAbort;
     std::mutex m_lock;
@@ -144,6 +163,8 @@ private:
     bool m_bAbort;
     bool m_bIdle;
     const milliseconds m_objMaxWaitingTime;
+    const ETimerQueueBackend m_eBackend;
+    const bool m_bWorkerLocalTimers;
     const FuncThreadDelegate m_funcStartedCallBack;
     const FuncThreadDelegate m_funcTerminatedCallback;
 
@@ -69,7 +69,7 @@ CYCoroutineEngine::~CYCoroutineEngine() noexcept
 SharePtr<CYTimerQueue> CYCoroutineEngine::TimerQueue() const noexcept
 {
     std::call_once(g_objTimerFlag, [&]() {
-        m_ptrTimerQueue = MakeShared<CYTimerQueue>(m_objEngineOptions.maxTimerQueueWaitTime, m_objEngineOptions.funStartedCallBack, m_objEngineOptions.funTerminatedCallBack);
+        m_ptrTimerQueue = MakeShared<CYTimerQueue>(m_objEngineOptions.maxTimerQueueWaitTime, m_objEngineOptions.funStartedCallBack, m_objEngineOptions.funTerminatedCallBack, m_objEngineOptions.timerQueueBackend, m_objEngineOptions.timerQueueWorkerLocal);
         });
 
     return m_ptrTimerQueue;
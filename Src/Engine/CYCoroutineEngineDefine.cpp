@@ -35,6 +35,8 @@ CYCoroutineOptions::CYCoroutineOptions() noexcept
     , maxBackgroundThreads(GetMaxBackgroundWorkers())
     , maxBackgroundExecutorWaitTime(DEFAULT_MAX_WORKER_WAIT_TIME)
     , maxTimerQueueWaitTime(std::chrono::seconds(MAX_TIMER_QUEUE_WORKER_WAIT_TIME_SEC))
+    , timerQueueBackend(ETimerQueueBackend::BACKEND_TIMER_SET)
+    , timerQueueWorkerLocal(false)
 {
 }
 
@@ -4,6 +4,8 @@
 #include "CYCoroutine/CYCoroutineDefine.hpp"
 #include "CYCoroutine/Executors/CYThreadPoolExecutor.hpp"
 #include "CYCoroutine/Results/Impl/CYBinarySemaphore.hpp"
+#include "CYCoroutine/Timers/CYTimerQueue.hpp"
+#include "Src/Timers/CYTimerWheel.hpp"
 
 #include <algorithm>
 
@@ -57,10 +59,18 @@ public:
     void ShutDown();
     bool AppearsEmpty() const noexcept;
     std::chrono::milliseconds MaxWorkerIdleTime() const noexcept;
+    CYThreadPoolExecutor& ParentPool() const noexcept;
+
+    void AddLocalTimer(const TimerPtr& ptrTimer);
+    void RemoveLocalTimer(TimerPtr ptrTimer);
 
 private:
     void BalanceWork();
 
+    bool HasLocalTimers() const noexcept;
+    bool LocalTimersDue() const noexcept;
+    void ProcessLocalTimers(RequestQueue& lstRequests);
+
     bool WaitForTask(UniqueLock& lock);
     bool DrainQueueImpl();
     bool DrainQueue();
@@ -89,6 +99,16 @@ private:
     std::atomic_bool m_bTaskFoundOrAbort;
     const FuncThreadDelegate m_funcStartedCallBack;
     const FuncThreadDelegate m_funcTerminatedCallback;
+
+    // worker-local timers, only touched by the worker thread.
+    UniquePtr<CYTimerWheel> m_ptrTimers;
+    TimePoint m_tpNextTimer = TimePoint::max();
+
+    // removals of worker-local timers cancelled on other threads, guarded by m_lock.
+    RequestQueue m_lstTimerRequests;
+
+    // CYTimerQueue::ShutdownEpoch() the local timers were last swept at.
+    size_t m_nTimerEpoch = 0;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -309,7 +329,7 @@ bool CYThreadPoolWorker::WaitForTask(UniqueLock& lock)
 {
     assert(lock.owns_lock());
 
-    if (!m_lstPublicTaskQueue.empty() || m_bAbort)
+    if (!m_lstPublicTaskQueue.empty() || !m_lstTimerRequests.empty() || m_bAbort)
     {
         return true;
     }
@@ -319,7 +339,13 @@ bool CYThreadPoolWorker::WaitForTask(UniqueLock& lock)
     m_objParentPool.MarkWorkerIdle(m_nIndex);
 
     auto event_found = false;
-    const auto deadline = std::chrono::steady_clock::now() + m_maxIdleTime;
+
+    // a worker holding local timers doesn't retire, it parks until the earliest of them instead.
+    const auto has_timers = HasLocalTimers();
+    const auto now = std::chrono::steady_clock::now();
+    const auto deadline = has_timers ?
+        now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(m_tpNextTimer - ClockType::now()) :
+        now + m_maxIdleTime;
 
     while (true)
     {
@@ -341,7 +367,7 @@ bool CYThreadPoolWorker::WaitForTask(UniqueLock& lock)
         }
 
         lock.lock();
-        if (m_lstPublicTaskQueue.empty() && !m_bAbort)
+        if (m_lstPublicTaskQueue.empty() && m_lstTimerRequests.empty() && !m_bAbort)
         {
             lock.unlock();
             continue;
@@ -356,14 +382,15 @@ bool CYThreadPoolWorker::WaitForTask(UniqueLock& lock)
         lock.lock();
     }
 
-    if (!event_found || m_bAbort)
+    if (m_bAbort || (!event_found && !has_timers))
     {
         m_bIdle = true;
         lock.unlock();
         return false;
     }
 
-    assert(!m_lstPublicTaskQueue.empty());
+    // woken by a task, a timer removal or a local timer coming due, the task queue may be empty.
+    assert(!event_found || !m_lstPublicTaskQueue.empty() || !m_lstTimerRequests.empty());
     m_objParentPool.MarkWorkerActive(m_nIndex);
     return true;
 }
@@ -374,6 +401,12 @@ bool CYThreadPoolWorker::DrainQueueImpl()
 
     while (!m_lstPrivTaskQueue.empty())
     {
+        if (LocalTimersDue())
+        {
+            RequestQueue lstNoRequests;
+            ProcessLocalTimers(lstNoRequests);
+        }
+
         BalanceWork();
 
         if (m_bAtomicAbort.load(std::memory_order_relaxed))
@@ -407,7 +440,6 @@ bool CYThreadPoolWorker::DrainQueue()
     }
 
     assert(lock.owns_lock());
-    assert(!m_lstPublicTaskQueue.empty() || m_bAbort);
 
     m_bTaskFoundOrAbort.store(false, std::memory_order_relaxed);
 
@@ -419,8 +451,16 @@ bool CYThreadPoolWorker::DrainQueue()
 
     assert(m_lstPrivTaskQueue.empty());
     std::swap(m_lstPrivTaskQueue, m_lstPublicTaskQueue);  // reuse underlying allocations.
+
+    RequestQueue lstTimerRequests;
+    std::swap(lstTimerRequests, m_lstTimerRequests);
     lock.unlock();
 
+    if (static_cast<bool>(m_ptrTimers))
+    {
+        ProcessLocalTimers(lstTimerRequests);
+    }
+
     return DrainQueueImpl();
 }
 
@@ -583,15 +623,22 @@ void CYThreadPoolWorker::ShutDown()
 
     decltype(m_lstPublicTaskQueue) lstPublicQueue;
     decltype(m_lstPrivTaskQueue) lstPrivateQueue;
+    decltype(m_lstTimerRequests) lstTimerRequests;
 
     {
         UniqueLock lock(m_lock);
         lstPublicQueue = std::move(m_lstPublicTaskQueue);
         lstPrivateQueue = std::move(m_lstPrivTaskQueue);
+        lstTimerRequests = std::move(m_lstTimerRequests);
     }
 
     lstPublicQueue.clear();
     lstPrivateQueue.clear();
+
+    // the worker thread is gone, the pending local timers are dropped with the pool.
+    lstTimerRequests.clear();
+    m_ptrTimers.reset();
+    m_tpNextTimer = TimePoint::max();
 }
 
 std::chrono::milliseconds CYThreadPoolWorker::MaxWorkerIdleTime() const noexcept
@@ -599,6 +646,82 @@ std::chrono::milliseconds CYThreadPoolWorker::MaxWorkerIdleTime() const noexcept
     return m_maxIdleTime;
 }
 
+CYThreadPoolExecutor& CYThreadPoolWorker::ParentPool() const noexcept
+{
+    return m_objParentPool;
+}
+
+void CYThreadPoolWorker::AddLocalTimer(const TimerPtr& ptrTimer)
+{
+    assert(m_objThreadPoolData.pPoolWorker == this);
+
+    if (!static_cast<bool>(m_ptrTimers))
+    {
+        m_ptrTimers = MakeUnique<CYTimerWheel>();
+    }
+
+    ptrTimer->SetLocalWorker(m_nIndex);
+    m_tpNextTimer = (std::min)(m_tpNextTimer, ptrTimer->GetDeadLine());
+    m_ptrTimers->Insert(ptrTimer);
+}
+
+void CYThreadPoolWorker::RemoveLocalTimer(TimerPtr ptrTimer)
+{
+    if (m_objThreadPoolData.pPoolWorker == this)
+    {
+        m_ptrTimers->Remove(ptrTimer.get());
+        return;
+    }
+
+    // the timer is already cancelled and won't run, the worker is woken up to unlink it. A retired
+    // worker holds no local timers.
+    UniqueLock lock(m_lock);
+    if (m_bAbort || m_bIdle)
+    {
+        return;
+    }
+
+    const auto bFirstRequest = m_lstTimerRequests.empty();
+    m_lstTimerRequests.emplace_back(std::move(ptrTimer), ETimerRequest::TYPE_TIMER_REQUEST_REMOVE);
+    m_bTaskFoundOrAbort.store(true, std::memory_order_relaxed);
+    lock.unlock();
+
+    if (bFirstRequest)
+    {
+        m_semaphore.release();
+    }
+}
+
+bool CYThreadPoolWorker::HasLocalTimers() const noexcept
+{
+    return static_cast<bool>(m_ptrTimers) && !m_ptrTimers->Empty();
+}
+
+bool CYThreadPoolWorker::LocalTimersDue() const noexcept
+{
+    return m_tpNextTimer != TimePoint::max() && m_tpNextTimer <= ClockType::now();
+}
+
+void CYThreadPoolWorker::ProcessLocalTimers(RequestQueue& lstRequests)
+{
+    assert(static_cast<bool>(m_ptrTimers));
+
+    // a timer queue was shut down since the last round, none of its timers may fire anymore.
+    const auto nEpoch = CYTimerQueue::ShutdownEpoch();
+    if (nEpoch != m_nTimerEpoch)
+    {
+        m_nTimerEpoch = nEpoch;
+        m_ptrTimers->RemoveIf([](const CYTimerStateBase& objTimer)
+            {
+                const auto ptrTimerQueue = objTimer.GetTimerQueue().lock();
+                return !static_cast<bool>(ptrTimerQueue) || ptrTimerQueue->ShutdownRequested();
+            });
+    }
+
+    const auto tpNextTimer = m_ptrTimers->ProcessTimers(lstRequests);
+    m_tpNextTimer = m_ptrTimers->Empty() ? TimePoint::max() : tpNextTimer;
+}
+
 bool CYThreadPoolWorker::AppearsEmpty() const noexcept
 {
     return m_lstPrivTaskQueue.empty() && !m_bTaskFoundOrAbort.load(std::memory_order_relaxed);
@@ -636,6 +759,25 @@ CYThreadPoolWorker& CYThreadPoolExecutor::WorkerAt(size_t index) noexcept
     return m_lstWorkers[index];
 }
 
+CYThreadPoolExecutor* CYThreadPoolExecutor::CurrentPool() noexcept
+{
+    const auto pPoolWorker = m_objThreadPoolData.pPoolWorker;
+    return pPoolWorker != nullptr ? &pPoolWorker->ParentPool() : nullptr;
+}
+
+void CYThreadPoolExecutor::AddLocalTimer(const SharePtr<CYTimerStateBase>& ptrTimer)
+{
+    assert(CurrentPool() == this);
+    m_objThreadPoolData.pPoolWorker->AddLocalTimer(ptrTimer);
+}
+
+void CYThreadPoolExecutor::RemoveLocalTimer(SharePtr<CYTimerStateBase> ptrTimer)
+{
+    const auto index = ptrTimer->GetLocalWorker();
+    assert(index < m_lstWorkers.size());
+    m_lstWorkers[index].RemoveLocalTimer(std::move(ptrTimer));
+}
+
 void CYThreadPoolExecutor::MarkWorkerIdle(size_t index) noexcept
 {
     assert(index < m_lstWorkers.size());
@@ -0,0 +1,339 @@
+#include "CYCoroutine/CYCoroutineDefine.hpp"
+#include "CYCoroutine/Executors/CYExecutor.hpp"
+#include "CYCoroutine/Results/CYSelect.hpp"
+
+#include <stdexcept>
+#include <thread>
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+/*
+ * CYSelectDeadline
+ */
+
+CYSelectDeadline::CYSelectDeadline(SharePtr<CYTimerQueue> ptrTimerQueue, milliseconds nDueTime, SharePtr<CYExecutor> ptrExecutor)
+    : ptrTimerQueue(std::move(ptrTimerQueue))
+    , nDueTime(nDueTime)
+    , ptrExecutor(std::move(ptrExecutor))
+{
+    if (!static_cast<bool>(this->ptrTimerQueue))
+    {
+        throw std::invalid_argument("CYSelectDeadline - timer queue is null.");
+    }
+
+    if (!static_cast<bool>(this->ptrExecutor))
+    {
+        throw std::invalid_argument("CYSelectDeadline - executor is null.");
+    }
+}
+
+/*
+ * CYSelectContext
+ */
+
+ /*
+  *   k_nRegistering -> k_nWaiting -> (winner) index
+  *     |                                 ^
+  *     |                                 |
+  *     -----------------------------------
+  */
+
+void CYSelectContext::SetCaller(coroutine_handle<void> handleCaller) noexcept
+{
+    assert(static_cast<bool>(handleCaller));
+    m_handleCaller = handleCaller;
+}
+
+coroutine_handle<void> CYSelectContext::Claim(size_t nIndex) noexcept
+{
+    auto nWinner = m_nWinner.load(std::memory_order_acquire);
+    while (nWinner == k_nRegistering || nWinner == k_nWaiting)
+    {
+        if (m_nWinner.compare_exchange_weak(nWinner, nIndex, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            // while registering, the registering thread picks the index up and doesn't suspend.
+            return nWinner == k_nWaiting ? m_handleCaller : coroutine_handle<void>{};
+        }
+    }
+
+    return {};  // another case won
+}
+
+bool CYSelectContext::Suspend() noexcept
+{
+    auto nExpected = k_nRegistering;
+    return m_nWinner.compare_exchange_strong(nExpected, k_nWaiting, std::memory_order_acq_rel, std::memory_order_acquire);
+}
+
+bool CYSelectContext::Claimed() const noexcept
+{
+    return m_nWinner.load(std::memory_order_acquire) != k_nRegistering;
+}
+
+size_t CYSelectContext::Winner() const noexcept
+{
+    const auto nWinner = m_nWinner.load(std::memory_order_acquire);
+    assert(nWinner != k_nRegistering && nWinner != k_nWaiting);
+    return nWinner;
+}
+
+/*
+ * CYSelectResultCase
+ */
+
+CYSelectResultCase::CYSelectResultCase(CYResultStateBase& objState) noexcept
+    : m_objState(objState)
+{
+}
+
+bool CYSelectResultCase::Ready() const noexcept
+{
+    return m_objState.ProducerDone();
+}
+
+bool CYSelectResultCase::Register(CYSelectContext& objContext, size_t nIndex) noexcept
+{
+    m_pContext = &objContext;
+    m_nIndex = nIndex;
+    m_bRegistered = m_objState.Then(*this);
+    return m_bRegistered;
+}
+
+void CYSelectResultCase::Deregister() noexcept
+{
+    if (!std::exchange(m_bRegistered, false))
+    {
+        return;
+    }
+
+    if (m_objState.TryRewindConsumer())
+    {
+        return;
+    }
+
+    // the producer already claimed the consumer slot and runs this case right after.
+    while (!m_bFired.load(std::memory_order_acquire))
+    {
+        std::this_thread::yield();
+    }
+}
+
+void CYSelectResultCase::Run() noexcept
+{
+    const auto handleCaller = m_pContext->Claim(m_nIndex);
+
+    // last touch of the case, the selecting coroutine may release it from here on.
+    m_bFired.store(true, std::memory_order_release);
+
+    if (static_cast<bool>(handleCaller))
+    {
+        handleCaller();
+    }
+}
+
+/*
+ * CYSelectSharedCase
+ */
+
+CYSelectSharedCase::CYSelectSharedCase(CYSharedResultStateBase& objState) noexcept
+    : m_objState(objState)
+{
+    pfnClaim = &CYSelectSharedCase::Claim;
+}
+
+bool CYSelectSharedCase::Ready() const noexcept
+{
+    return m_objState.Status() != EResultStatus::STATUS_RESULT_IDLE;
+}
+
+bool CYSelectSharedCase::Register(CYSelectContext& objContext, size_t nIndex) noexcept
+{
+    m_pContext = &objContext;
+    m_nIndex = nIndex;
+    m_bRegistered = m_objState.await(*this);
+    return m_bRegistered;
+}
+
+void CYSelectSharedCase::Deregister() noexcept
+{
+    if (!std::exchange(m_bRegistered, false))
+    {
+        return;
+    }
+
+    if (m_objState.TryRemove(*this))
+    {
+        return;
+    }
+
+    // the result finished and is settling its awaiters, this case included.
+    while (!m_bFired.load(std::memory_order_acquire))
+    {
+        std::this_thread::yield();
+    }
+}
+
+bool CYSelectSharedCase::Claim(CYSharedAwaitContext& self) noexcept
+{
+    auto& objCase = static_cast<CYSelectSharedCase&>(self);
+    objCase.handleCaller = objCase.m_pContext->Claim(objCase.m_nIndex);
+
+    // a winner stays queued until resumed, the coroutine can't release it before that.
+    const auto bResume = static_cast<bool>(objCase.handleCaller);
+    objCase.m_bFired.store(true, std::memory_order_release);
+    return bResume;
+}
+
+/*
+ * CYSelectTimerFunctor
+ */
+
+CYSelectTimerCase* CYSelectTimerFunctor::BusyConstant() noexcept
+{
+    return reinterpret_cast<CYSelectTimerCase*>(-1);
+}
+
+CYSelectTimerFunctor::CYSelectTimerFunctor(CYSelectTimerCase* pCase) noexcept
+    : m_pCase(pCase)
+{
+    assert(pCase != nullptr);
+}
+
+CYSelectTimerFunctor::CYSelectTimerFunctor(CYSelectTimerFunctor&& rhs) noexcept
+    : m_pCase(rhs.m_pCase.exchange(nullptr, std::memory_order_relaxed))
+{
+}
+
+void CYSelectTimerFunctor::operator()() noexcept
+{
+    auto pCase = m_pCase.load(std::memory_order_acquire);
+    if (pCase == nullptr || pCase == BusyConstant())
+    {
+        return;
+    }
+
+    if (!m_pCase.compare_exchange_strong(pCase, BusyConstant(), std::memory_order_acq_rel, std::memory_order_acquire))
+    {
+        return;  // detached meanwhile
+    }
+
+    const auto handleCaller = pCase->Fire();
+    m_pCase.store(nullptr, std::memory_order_release);
+
+    if (static_cast<bool>(handleCaller))
+    {
+        handleCaller();
+    }
+}
+
+void CYSelectTimerFunctor::Detach() noexcept
+{
+    auto pCase = m_pCase.load(std::memory_order_acquire);
+    while (pCase != nullptr)
+    {
+        if (pCase == BusyConstant())
+        {
+            // the expiry is claiming right now, it doesn't resume anything before letting go.
+            std::this_thread::yield();
+            pCase = m_pCase.load(std::memory_order_acquire);
+            continue;
+        }
+
+        if (m_pCase.compare_exchange_weak(pCase, nullptr, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            return;
+        }
+    }
+}
+
+/*
+ * CYSelectTimerCase
+ */
+
+CYSelectTimerCase::CYSelectTimerCase(const CYSelectDeadline& objDeadline) noexcept
+    : m_objDeadline(objDeadline)
+{
+}
+
+bool CYSelectTimerCase::Ready() const noexcept
+{
+    return m_objDeadline.nDueTime.count() <= 0;
+}
+
+bool CYSelectTimerCase::Register(CYSelectContext& objContext, size_t nIndex)
+{
+    m_pContext = &objContext;
+    m_nIndex = nIndex;
+
+    auto ptrTimer = m_objDeadline.ptrTimerQueue->MakeTimerImpl(static_cast<size_t>(m_objDeadline.nDueTime.count()), 0, m_objDeadline.ptrExecutor, true, CYSelectTimerFunctor{ this });
+    m_pFunctor = &static_cast<CYTimerState<CYSelectTimerFunctor>&>(*ptrTimer).Callable();
+    m_objTimer = CYTimer(std::move(ptrTimer));
+    return true;
+}
+
+void CYSelectTimerCase::Deregister() noexcept
+{
+    const auto pFunctor = std::exchange(m_pFunctor, nullptr);
+    if (pFunctor == nullptr)
+    {
+        return;
+    }
+
+    pFunctor->Detach();
+
+    try
+    {
+        m_objTimer.Cancel();
+    }
+    catch (...)
+    {
+        // the timer stays queued and expires into a detached functor.
+    }
+}
+
+coroutine_handle<void> CYSelectTimerCase::Fire() noexcept
+{
+    return m_pContext->Claim(m_nIndex);
+}
+
+/*
+ * CYSelectCancellationCase
+ */
+
+CYSelectCancellationCase::CYSelectCancellationCase(const CYCancellationToken& token) noexcept
+    : m_token(token)
+{
+}
+
+bool CYSelectCancellationCase::Ready() const noexcept
+{
+    return m_token.IsCancelled();
+}
+
+bool CYSelectCancellationCase::Register(CYSelectContext& objContext, size_t nIndex) noexcept
+{
+    m_pContext = &objContext;
+    m_nIndex = nIndex;
+    m_bRegistered = m_token.Register(*this);
+    return m_bRegistered;
+}
+
+void CYSelectCancellationCase::Deregister() noexcept
+{
+    if (std::exchange(m_bRegistered, false))
+    {
+        // waits for an OnCancel() running on another thread.
+        m_token.Deregister(*this);
+    }
+}
+
+void CYSelectCancellationCase::OnCancel() noexcept
+{
+    const auto handleCaller = m_pContext->Claim(m_nIndex);
+    if (static_cast<bool>(handleCaller))
+    {
+        handleCaller();
+    }
+}
+
+CYCOROUTINE_NAMESPACE_END
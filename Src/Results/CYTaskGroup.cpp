@@ -0,0 +1,208 @@
+#include "CYCommon/Common/Exception/CYException.hpp"
+
+#include "CYCoroutine/Results/CYTaskGroup.hpp"
+
+#include <stdexcept>
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+/*
+    CYTaskGroupPromise
+*/
+CYTaskGroupPromise::CYStartAwaiter::CYStartAwaiter(CYTaskGroupPromise& promise) noexcept
+    : m_promise(promise)
+{
+}
+
+void CYTaskGroupPromise::CYStartAwaiter::await_resume() const
+{
+    // thrown into the child, unhandled_exception() reports it to the group.
+    IfTrueThrow(m_promise.m_bInterrupted, TEXT("CYResult - associated task was interrupted abnormally"));
+    m_promise.m_pGroup->Token().ThrowIfCancelled();
+}
+
+CYTaskGroupPromise::CYFinalAwaiter::CYFinalAwaiter(CYTaskGroup& group) noexcept
+    : m_group(group)
+{
+}
+
+void CYTaskGroupPromise::CYFinalAwaiter::await_suspend(coroutine_handle<void> handle) const noexcept
+{
+    // the awaiter lives in the frame, the group is read before the frame goes away.
+    auto& group = m_group;
+    handle.destroy();
+    group.Arrive();
+}
+
+CYTaskGroupChild CYTaskGroupPromise::get_return_object() noexcept
+{
+    return { coroutine_handle<CYTaskGroupPromise>::from_promise(*this) };
+}
+
+CYTaskGroupPromise::CYStartAwaiter CYTaskGroupPromise::initial_suspend() noexcept
+{
+    return { *this };
+}
+
+CYTaskGroupPromise::CYFinalAwaiter CYTaskGroupPromise::final_suspend() const noexcept
+{
+    assert(m_pGroup != nullptr);
+    return { *m_pGroup };
+}
+
+void CYTaskGroupPromise::unhandled_exception() noexcept
+{
+    m_pGroup->Fail(std::current_exception());
+}
+
+void CYTaskGroupPromise::return_void() const noexcept
+{
+}
+
+void CYTaskGroupPromise::Start(CYTaskGroup& group, CYExecutor& executor) noexcept
+{
+    m_pGroup = &group;
+
+    try
+    {
+        executor.Post(CYAwaitViaFunctor{ coroutine_handle<CYTaskGroupPromise>::from_promise(*this), &m_bInterrupted });
+    }
+    catch (...)
+    {
+        // do nothing. ~CYAwaitViaFunctor resumes the child, which fails the group and counts down.
+    }
+}
+
+/*
+    CYTaskGroupJoinAwaiter
+*/
+CYTaskGroupJoinAwaiter::CYTaskGroupJoinAwaiter(CYTaskGroup& parent, SharePtr<CYExecutor> ptrResumeExecutor) noexcept
+    : m_parent(parent)
+    , m_ptrResumeExecutor(std::move(ptrResumeExecutor))
+{
+}
+
+bool CYTaskGroupJoinAwaiter::await_ready() const noexcept
+{
+    return m_parent.m_nPending.load(std::memory_order_acquire) == 1;
+}
+
+bool CYTaskGroupJoinAwaiter::await_suspend(coroutine_handle<void> hHandle) noexcept
+{
+    assert(static_cast<bool>(hHandle));
+    assert(!hHandle.done());
+
+    m_handleResume = hHandle;
+    m_parent.m_pJoiner = this;
+
+    // drops the group's own count, false: the children finished meanwhile, go on inline.
+    return m_parent.m_nPending.fetch_sub(1, std::memory_order_acq_rel) != 1;
+}
+
+void CYTaskGroupJoinAwaiter::await_resume()
+{
+    // every child is gone, rearm the group for the next round, also when the joiner was interrupted.
+    m_parent.m_pJoiner = nullptr;
+    m_parent.m_nPending.store(1, std::memory_order_relaxed);
+
+    if (m_parent.m_objSource.IsCancelled())
+    {
+        m_parent.m_objSource = CYCancellationSource();
+    }
+
+    std::exception_ptr pException;
+    if (m_parent.m_bFailed.exchange(false, std::memory_order_acquire))
+    {
+        pException = std::exchange(m_parent.m_pException, nullptr);
+    }
+
+    IfTrueThrow(m_bInterrupted, TEXT("CYResult - associated task was interrupted abnormally"));
+
+    if (pException != nullptr)
+    {
+        std::rethrow_exception(pException);
+    }
+}
+
+/*
+    CYTaskGroup
+*/
+CYTaskGroup::CYTaskGroup(ETaskGroupPolicy ePolicy)
+    : m_ePolicy(ePolicy)
+{
+}
+
+CYTaskGroup::~CYTaskGroup() noexcept
+{
+#ifdef CYCOROUTINE_DEBUG_MODE
+    assert(m_nPending.load(std::memory_order_acquire) == 1 && "CYTaskGroup is destroyed while children are still running.");
+#endif
+}
+
+ETaskGroupPolicy CYTaskGroup::Policy() const noexcept
+{
+    return m_ePolicy;
+}
+
+CYCancellationToken CYTaskGroup::Token() const noexcept
+{
+    return m_objSource.Token();
+}
+
+void CYTaskGroup::Cancel() noexcept
+{
+    m_objSource.Cancel();
+}
+
+CYTaskGroupJoinAwaiter CYTaskGroup::Join(SharePtr<CYExecutor> ptrResumeExecutor)
+{
+    if (!static_cast<bool>(ptrResumeExecutor))
+    {
+        throw std::invalid_argument("CYTaskGroup::Join() - given resume CYExecutor is null.");
+    }
+
+    return CYTaskGroupJoinAwaiter(*this, std::move(ptrResumeExecutor));
+}
+
+void CYTaskGroup::VerifyExecutor(const CYExecutor* pExecutor)
+{
+    if (pExecutor == nullptr)
+    {
+        throw std::invalid_argument("CYTaskGroup::Spawn() - given CYExecutor is null.");
+    }
+}
+
+void CYTaskGroup::Launch(CYExecutor& executor, CYTaskGroupChild objChild) noexcept
+{
+    m_nPending.fetch_add(1, std::memory_order_relaxed);
+    objChild.handle.promise().Start(*this, executor);
+}
+
+void CYTaskGroup::Fail(std::exception_ptr pException) noexcept
+{
+    if (!m_bFailed.exchange(true, std::memory_order_acq_rel))
+    {
+        m_pException = std::move(pException);
+    }
+
+    if (m_ePolicy == ETaskGroupPolicy::POLICY_CANCEL_ON_FAILURE)
+    {
+        m_objSource.Cancel();
+    }
+}
+
+void CYTaskGroup::Arrive() noexcept
+{
+    if (m_nPending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+    {
+        return;
+    }
+
+    // the last child after Join() dropped the group's count.
+    const auto pJoiner = m_pJoiner;
+    assert(pJoiner != nullptr);
+
+    CYAwaitViaFunctor::Post(*pJoiner->m_ptrResumeExecutor, pJoiner->m_handleResume, &pJoiner->m_bInterrupted);
+}
+
+CYCOROUTINE_NAMESPACE_END
@@ -1,3 +1,5 @@
+#include "CYCommon/Common/Exception/CYException.hpp"
+
 #include "CYCoroutine/CYCoroutineDefine.hpp"
 #include "CYCoroutine/Executors/CYExecutor.hpp"
 #include "CYCoroutine/Results/Impl/CYConsumerContext.hpp"
@@ -7,7 +9,11 @@
 using CYCOROUTINE_NAMESPACE::CYWhenAnyContext;
 using CYCOROUTINE_NAMESPACE::CYConsumerContext;
 using CYCOROUTINE_NAMESPACE::CYAwaitViaFunctor;
+using CYCOROUTINE_NAMESPACE::CYCompletionContext;
+using CYCOROUTINE_NAMESPACE::CYCompletionNode;
+using CYCOROUTINE_NAMESPACE::CYCountdownContext;
 using CYCOROUTINE_NAMESPACE::CYResultStateBase;
+using CYCOROUTINE_NAMESPACE::coroutine_handle;
 
 CYCOROUTINE_NAMESPACE_BEGIN
 
@@ -62,6 +68,23 @@ void CYAwaitViaFunctor::operator()() noexcept
     m_handleCaller();
 }
 
+void CYAwaitViaFunctor::Post(CYExecutor& executor, coroutine_handle<void> handleCaller, bool* pbInterrupted) noexcept
+{
+    try
+    {
+        executor.Post(CYAwaitViaFunctor{ handleCaller, pbInterrupted });
+    }
+    catch (...)
+    {
+        // the broken task resumed the coroutine with *pbInterrupted set, nothing to do here.
+    }
+}
+
+void CYAwaitViaFunctor::ThrowInterrupted()
+{
+    IfTrueThrow(true, TEXT("CYResult - associated task was interrupted abnormally"));
+}
+
 /*
  * CYWhenAnyContext
  */
@@ -168,6 +191,120 @@ const CYResultStateBase* CYWhenAnyContext::CompletedResult() const noexcept
     return m_status.load(std::memory_order_acquire);
 }
 
+/*
+ * CYCountdownContext
+ */
+
+CYCountdownContext::CYCountdownContext(size_t nCount) noexcept
+    : m_nPending(nCount + 1)
+{
+}
+
+void CYCountdownContext::SetCaller(coroutine_handle<void> handleCaller) noexcept
+{
+    assert(static_cast<bool>(handleCaller));
+    m_handleCaller = handleCaller;
+}
+
+void CYCountdownContext::Arrive() noexcept
+{
+    if (m_nPending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        m_handleCaller();
+    }
+}
+
+bool CYCountdownContext::Suspend(size_t nArrived) noexcept
+{
+    // drops the count held during registration together with the results that were already done,
+    // if that was the rest of it nobody is left to resume the caller
+    const auto nDrop = nArrived + 1;
+    return m_nPending.fetch_sub(nDrop, std::memory_order_acq_rel) != nDrop;
+}
+
+/*
+ * CYCompletionContext
+ */
+
+ /*
+  *   m_pHead: nullptr (empty) -> WaiterConstant() (empty, consumer parked) -> stack of completed nodes
+  *   producers push onto the stack, the consumer grabs the whole stack and reverses it into m_pReady,
+  *   so nodes come out in completion order at O(1) amortized cost.
+  */
+
+CYCompletionNode* CYCompletionContext::WaiterConstant() noexcept
+{
+    return reinterpret_cast<CYCompletionNode*>(-1);
+}
+
+void CYCompletionContext::Push(CYCompletionNode& objNode) noexcept
+{
+    auto pHead = m_pHead.load(std::memory_order_acquire);
+    while (true)
+    {
+        if (pHead == WaiterConstant())
+        {
+            objNode.next = nullptr;
+            if (m_pHead.compare_exchange_weak(pHead, &objNode, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                // the consumer is parked and can't release the context before it is resumed
+                auto handleWaiter = m_handleWaiter;
+                objNode.bQueued.store(true, std::memory_order_release);
+                return handleWaiter();
+            }
+
+            continue;
+        }
+
+        objNode.next = pHead;
+        if (m_pHead.compare_exchange_weak(pHead, &objNode, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            // last touch of the node/context, the owner waits on it before tearing down
+            objNode.bQueued.store(true, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+CYCompletionNode* CYCompletionContext::TryPop() noexcept
+{
+    if (m_pReady == nullptr)
+    {
+        auto pHead = m_pHead.load(std::memory_order_acquire);
+        if (pHead == nullptr || pHead == WaiterConstant())
+        {
+            return nullptr;
+        }
+
+        pHead = m_pHead.exchange(nullptr, std::memory_order_acq_rel);
+        assert(pHead != nullptr && pHead != WaiterConstant());
+
+        CYCompletionNode* pPrev = nullptr;
+        while (pHead != nullptr)
+        {
+            auto pNext = pHead->next;
+            pHead->next = pPrev;
+            pPrev = pHead;
+            pHead = pNext;
+        }
+
+        m_pReady = pPrev;
+    }
+
+    auto pNode = m_pReady;
+    m_pReady = pNode->next;
+    return pNode;
+}
+
+bool CYCompletionContext::Suspend(coroutine_handle<void> handleCaller) noexcept
+{
+    assert(m_pReady == nullptr);
+    m_handleWaiter = handleCaller;
+
+    CYCompletionNode* pExpected = nullptr;
+    return m_pHead.compare_exchange_strong(pExpected, WaiterConstant(), std::memory_order_acq_rel, std::memory_order_acquire);
+}
+
 /*
  * CYConsumerContext
  */
@@ -191,7 +328,7 @@ void CYConsumerContext::Destroy() noexcept
     }
     case EConsumerStatus::STATUS_CONSUMER_WAITFOR:
     {
-        return CYCOROUTINE_NAMESPACE::Destroy(m_storage.wait_for_ctx);
+        return CYCOROUTINE_NAMESPACE::Destroy(m_storage.pWaitForCtx);
     }
     case EConsumerStatus::STATUS_CONSUMER_WHENANY:
     {
@@ -201,6 +338,18 @@ void CYConsumerContext::Destroy() noexcept
     {
         return CYCOROUTINE_NAMESPACE::Destroy(m_storage.ptrSharedCtx);
     }
+    case EConsumerStatus::STATUS_CONSUMER_COMPLETION:
+    {
+        return CYCOROUTINE_NAMESPACE::Destroy(m_storage.pCompletionNode);
+    }
+    case EConsumerStatus::STATUS_CONSUMER_COUNTDOWN:
+    {
+        return CYCOROUTINE_NAMESPACE::Destroy(m_storage.pCountdownCtx);
+    }
+    case EConsumerStatus::STATUS_CONSUMER_CONTINUATION:
+    {
+        return CYCOROUTINE_NAMESPACE::Destroy(m_storage.pContinuation);
+    }
     }
 
     assert(false);
@@ -219,11 +368,11 @@ void CYConsumerContext::SetAwaitHandle(coroutine_handle<void> handleCaller) noex
     Build(m_storage.handleCaller, handleCaller);
 }
 
-void CYConsumerContext::SetWaitForContext(const SharePtr<cy_binary_semaphore>& ptrWaitCtx) noexcept
+void CYConsumerContext::SetWaitForContext(cy_binary_semaphore* pWaitCtx) noexcept
 {
     assert(m_status == EConsumerStatus::STATUS_CONSUMER_IDLE);
     m_status = EConsumerStatus::STATUS_CONSUMER_WAITFOR;
-    Build(m_storage.wait_for_ctx, ptrWaitCtx);
+    Build(m_storage.pWaitForCtx, pWaitCtx);
 }
 
 void CYConsumerContext::SetWhenAnyContext(const SharePtr<CYWhenAnyContext>& ptrWhenAnyCtx) noexcept
@@ -240,6 +389,27 @@ void CYConsumerContext::SetSharedContext(const SharePtr<CYSharedResultStateBase>
     Build(m_storage.ptrSharedCtx, ptrSharedCtx);
 }
 
+void CYConsumerContext::SetCompletionContext(CYCompletionNode* pCompletionNode) noexcept
+{
+    assert(m_status == EConsumerStatus::STATUS_CONSUMER_IDLE);
+    m_status = EConsumerStatus::STATUS_CONSUMER_COMPLETION;
+    Build(m_storage.pCompletionNode, pCompletionNode);
+}
+
+void CYConsumerContext::SetCountdownContext(CYCountdownContext* pCountdownCtx) noexcept
+{
+    assert(m_status == EConsumerStatus::STATUS_CONSUMER_IDLE);
+    m_status = EConsumerStatus::STATUS_CONSUMER_COUNTDOWN;
+    Build(m_storage.pCountdownCtx, pCountdownCtx);
+}
+
+void CYConsumerContext::SetContinuation(CYContinuationBase* pContinuation) noexcept
+{
+    assert(m_status == EConsumerStatus::STATUS_CONSUMER_IDLE);
+    m_status = EConsumerStatus::STATUS_CONSUMER_CONTINUATION;
+    Build(m_storage.pContinuation, pContinuation);
+}
+
 void CYConsumerContext::ResumeConsumer(CYResultStateBase& self) const
 {
     switch (m_status)
@@ -259,9 +429,9 @@ void CYConsumerContext::ResumeConsumer(CYResultStateBase& self) const
 
     case EConsumerStatus::STATUS_CONSUMER_WAITFOR:
     {
-        const auto ptrWaitCtx = m_storage.wait_for_ctx;
-        assert(static_cast<bool>(ptrWaitCtx));
-        return ptrWaitCtx->release();
+        const auto pWaitCtx = m_storage.pWaitForCtx;
+        assert(pWaitCtx != nullptr);
+        return pWaitCtx->release();
     }
 
     case EConsumerStatus::STATUS_CONSUMER_WHENANY:
@@ -280,7 +450,44 @@ void CYConsumerContext::ResumeConsumer(CYResultStateBase& self) const
         }
         return;
     }
+
+    case EConsumerStatus::STATUS_CONSUMER_COMPLETION:
+    {
+        const auto pCompletionNode = m_storage.pCompletionNode;
+        assert(pCompletionNode != nullptr);
+        return pCompletionNode->pContext->Push(*pCompletionNode);
+    }
+
+    case EConsumerStatus::STATUS_CONSUMER_COUNTDOWN:
+    {
+        const auto pCountdownCtx = m_storage.pCountdownCtx;
+        assert(pCountdownCtx != nullptr);
+        return pCountdownCtx->Arrive();
+    }
+
+    case EConsumerStatus::STATUS_CONSUMER_CONTINUATION:
+    {
+        const auto pContinuation = m_storage.pContinuation;
+        assert(pContinuation != nullptr);
+        return pContinuation->Run();
+    }
     }
 
     assert(false);
+}
+
+coroutine_handle<void> CYConsumerContext::TransferConsumer(CYResultStateBase& self) const
+{
+    // an awaiting coroutine is handed back to the finishing producer, which jumps to it
+    // from final_suspend instead of resuming it on top of its own frame.
+    if (m_status == EConsumerStatus::STATUS_CONSUMER_AWAIT)
+    {
+        auto handleCaller = m_storage.handleCaller;
+        assert(static_cast<bool>(handleCaller));
+        assert(!handleCaller.done());
+        return handleCaller;
+    }
+
+    ResumeConsumer(self);
+    return std::noop_coroutine();
 }
\ No newline at end of file
@@ -9,6 +9,12 @@ void CYResultStateBase::AssertDone() const noexcept
     assert(m_eResultState.load(std::memory_order_acquire) == EResultState::STATE_RESULT_PRODUCER_DONE);
 }
 
+cy_binary_semaphore& CYResultStateBase::WaitForSemaphore() noexcept
+{
+    static thread_local cy_binary_semaphore s_objSemaphore{ 0 };
+    return s_objSemaphore;
+}
+
 void CYResultStateBase::Wait()
 {
     const auto state = m_eResultState.load(std::memory_order_acquire);
@@ -103,12 +109,88 @@ void CYResultStateBase::Share(const SharePtr<CYSharedResultStateBase>& resultSta
     resultState->OnResultFinished();
 }
 
-void CYResultStateBase::TryRewindConsumer() noexcept
+bool CYResultStateBase::WhenComplete(CYCompletionNode& objNode) noexcept
+{
+    const auto state = m_eResultState.load(std::memory_order_acquire);
+    if (state == EResultState::STATE_RESULT_PRODUCER_DONE)
+    {
+        return false;
+    }
+
+    m_objConsumer.SetCompletionContext(&objNode);
+
+    auto eExpectedState = EResultState::STATE_RESULT_IDLE;
+    const auto idle = m_eResultState.compare_exchange_strong(eExpectedState, EResultState::STATE_RESULT_CONSUMER_SET, std::memory_order_acq_rel, std::memory_order_acquire);
+
+    if (!idle)
+    {
+        AssertDone();
+        m_objConsumer.Clear();
+    }
+
+    return idle;  // if idle = false, the caller has to queue the node itself
+}
+
+bool CYResultStateBase::WhenALL(CYCountdownContext& objCountdown) noexcept
+{
+    const auto state = m_eResultState.load(std::memory_order_acquire);
+    if (state == EResultState::STATE_RESULT_PRODUCER_DONE)
+    {
+        return false;
+    }
+
+    m_objConsumer.SetCountdownContext(&objCountdown);
+
+    auto eExpectedState = EResultState::STATE_RESULT_IDLE;
+    const auto idle = m_eResultState.compare_exchange_strong(eExpectedState, EResultState::STATE_RESULT_CONSUMER_SET, std::memory_order_acq_rel, std::memory_order_acquire);
+
+    if (!idle)
+    {
+        AssertDone();
+        m_objConsumer.Clear();
+    }
+
+    return idle;  // if idle = false, the caller has to count the result down itself
+}
+
+bool CYResultStateBase::Then(CYContinuationBase& objContinuation) noexcept
+{
+    const auto state = m_eResultState.load(std::memory_order_acquire);
+    if (state == EResultState::STATE_RESULT_PRODUCER_DONE)
+    {
+        return false;
+    }
+
+    m_objConsumer.SetContinuation(&objContinuation);
+
+    auto eExpectedState = EResultState::STATE_RESULT_IDLE;
+    const auto idle = m_eResultState.compare_exchange_strong(eExpectedState, EResultState::STATE_RESULT_CONSUMER_SET, std::memory_order_acq_rel, std::memory_order_acquire);
+
+    if (!idle)
+    {
+        AssertDone();
+        m_objConsumer.Clear();
+    }
+
+    return idle;  // if idle = false, the caller has to run the continuation itself
+}
+
+bool CYResultStateBase::ProducerDone() const noexcept
+{
+    return m_eResultState.load(std::memory_order_acquire) == EResultState::STATE_RESULT_PRODUCER_DONE;
+}
+
+bool CYResultStateBase::TryRewindConsumer() noexcept
 {
     const auto EResultState = m_eResultState.load(std::memory_order_acquire);
+    if (EResultState == EResultState::STATE_RESULT_PRODUCER_DONE)
+    {
+        return false;
+    }
+
     if (EResultState != EResultState::STATE_RESULT_CONSUMER_SET)
     {
-        return;
+        return true;
     }
 
     auto eExpectedConsumerState = EResultState::STATE_RESULT_CONSUMER_SET;
@@ -117,10 +199,11 @@ void CYResultStateBase::TryRewindConsumer() noexcept
     if (!consumer)
     {
         AssertDone();
-        return;
+        return false;
     }
 
     m_objConsumer.Clear();
+    return true;
 }
 
 CYCOROUTINE_NAMESPACE_END
\ No newline at end of file
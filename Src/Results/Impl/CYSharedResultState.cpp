@@ -1,13 +1,72 @@
 #include "CYCoroutine/CYCoroutineDefine.hpp"
 #include "CYCoroutine/Results/Impl/CYSharedResultState.hpp"
+#include "CYCoroutine/Executors/CYExecutor.hpp"
+
+#include <algorithm>
+#include <vector>
 
 CYCOROUTINE_NAMESPACE_BEGIN
 
+namespace
+{
+    // Resumes nCount awaiters starting at pHead, a batch that is dropped unrun resumes them inline.
+    class CYSharedResumeFunctor
+    {
+    public:
+        CYSharedResumeFunctor(CYSharedAwaitContext* pHead, size_t nCount) noexcept
+            : m_pHead(pHead)
+            , m_nCount(nCount)
+        {
+        }
+
+        CYSharedResumeFunctor(CYSharedResumeFunctor&& rhs) noexcept
+            : m_pHead(std::exchange(rhs.m_pHead, nullptr))
+            , m_nCount(std::exchange(rhs.m_nCount, 0))
+        {
+        }
+
+        ~CYSharedResumeFunctor() noexcept
+        {
+            Resume();
+        }
+
+        void operator()() noexcept
+        {
+            Resume();
+        }
+
+    private:
+        void Resume() noexcept
+        {
+            auto pAwaiter = std::exchange(m_pHead, nullptr);
+            const auto nCount = std::exchange(m_nCount, 0);
+            for (size_t i = 0; i < nCount; i++)
+            {
+                // the context lives in the awaiting frame, read it before resuming.
+                assert(static_cast<bool>(pAwaiter->handleCaller));
+                auto handleCaller = pAwaiter->handleCaller;
+                pAwaiter = pAwaiter->next;
+                handleCaller();
+            }
+        }
+
+    private:
+        CYSharedAwaitContext* m_pHead;
+        size_t m_nCount;
+    };
+}
+
 CYSharedAwaitContext* CYSharedResultStateBase::ResultReadyConstant() noexcept
 {
     return reinterpret_cast<CYSharedAwaitContext*>(-1);
 }
 
+// set on the stack head while TryRemove() walks it, pushes and the completion wait meanwhile.
+bool CYSharedResultStateBase::Locked(CYSharedAwaitContext* pAwaiters) noexcept
+{
+    return pAwaiters != ResultReadyConstant() && (reinterpret_cast<uintptr_t>(pAwaiters) & 1) != 0;
+}
+
 EResultStatus CYSharedResultStateBase::Status() const noexcept
 {
     return m_status.load(std::memory_order_acquire);
@@ -23,6 +82,12 @@ bool CYSharedResultStateBase::await(CYSharedAwaitContext& awaiter) noexcept
             return false;
         }
 
+        if (Locked(awaiter_before))
+        {
+            CYSpinWait::Relax();
+            continue;
+        }
+
         awaiter.next = awaiter_before;
         const auto swapped = m_awaiters.compare_exchange_weak(awaiter_before, &awaiter, std::memory_order_acq_rel);
         if (swapped)
@@ -32,6 +97,145 @@ bool CYSharedResultStateBase::await(CYSharedAwaitContext& awaiter) noexcept
     }
 }
 
+bool CYSharedResultStateBase::TryRemove(CYSharedAwaitContext& awaiter) noexcept
+{
+    auto pHead = m_awaiters.load(std::memory_order_acquire);
+    while (true)
+    {
+        if (pHead == ResultReadyConstant())
+        {
+            return false;
+        }
+
+        if (Locked(pHead))
+        {
+            CYSpinWait::Relax();
+            pHead = m_awaiters.load(std::memory_order_acquire);
+            continue;
+        }
+
+        const auto pLocked = reinterpret_cast<CYSharedAwaitContext*>(reinterpret_cast<uintptr_t>(pHead) | 1);
+        if (m_awaiters.compare_exchange_weak(pHead, pLocked, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            break;
+        }
+    }
+
+    // nobody else changes the links while the head is locked.
+    auto ppLink = &pHead;
+    while (*ppLink != nullptr && *ppLink != &awaiter)
+    {
+        ppLink = &(*ppLink)->next;
+    }
+
+    const auto bFound = *ppLink != nullptr;
+    if (bFound)
+    {
+        *ppLink = awaiter.next;
+    }
+
+    m_awaiters.store(pHead, std::memory_order_release);
+    return bFound;
+}
+
+void CYSharedResultStateBase::SetResumeExecutor(const SharePtr<CYExecutor>& ptrExecutor, size_t nBatchSize) noexcept
+{
+    assert(nBatchSize != 0 || !static_cast<bool>(ptrExecutor));
+    m_ptrResumeExecutor = ptrExecutor;
+    m_nBatchSize = nBatchSize;
+}
+
+void CYSharedResultStateBase::ResumeAwaiters() noexcept
+{
+    auto awaiters = m_awaiters.load(std::memory_order_acquire);
+    while (Locked(awaiters) || !m_awaiters.compare_exchange_weak(awaiters, ResultReadyConstant(), std::memory_order_acq_rel, std::memory_order_acquire))
+    {
+        if (Locked(awaiters))
+        {
+            CYSpinWait::Relax();
+            awaiters = m_awaiters.load(std::memory_order_acquire);
+        }
+    }
+
+    // the stack is LIFO, awaiters are resumed in the order they arrived.
+    CYSharedAwaitContext* current = awaiters;
+    CYSharedAwaitContext* prev = nullptr, * next = nullptr;
+
+    while (current != nullptr)
+    {
+        next = current->next;
+        current->next = prev;
+        prev = current;
+        current = next;
+    }
+
+    // gated awaiters settle before anyone is resumed, losers drop out and are not touched again.
+    awaiters = nullptr;
+    auto ppTail = &awaiters;
+    size_t nCount = 0;
+
+    for (current = prev; current != nullptr; current = next)
+    {
+        next = current->next;
+        if (current->pfnClaim != nullptr && !current->pfnClaim(*current))
+        {
+            continue;
+        }
+
+        *ppTail = current;
+        ppTail = &current->next;
+        nCount++;
+    }
+
+    *ppTail = nullptr;
+
+    if (!static_cast<bool>(m_ptrResumeExecutor) || nCount <= m_nBatchSize)
+    {
+        CYSharedResumeFunctor(awaiters, nCount)();
+        return;
+    }
+
+    // the first batch stays on this thread, the rest is handed out in one Enqueue.
+    CYSharedResumeFunctor objFirstBatch(awaiters, m_nBatchSize);
+
+    auto pRest = awaiters;
+    for (size_t i = 0; i < m_nBatchSize; i++)
+    {
+        pRest = pRest->next;
+    }
+
+    auto nRest = nCount - m_nBatchSize;
+
+    try
+    {
+        std::vector<CYTask> tasks;
+        tasks.reserve((nRest + m_nBatchSize - 1) / m_nBatchSize);
+
+        while (nRest != 0)
+        {
+            const auto nBatch = (std::min)(nRest, m_nBatchSize);
+            auto pBatch = pRest;
+            for (size_t i = 0; i < nBatch; i++)
+            {
+                pRest = pRest->next;
+            }
+
+            nRest -= nBatch;
+            tasks.emplace_back(CYSharedResumeFunctor(pBatch, nBatch));
+        }
+
+        std::span<CYTask> span = tasks;
+        m_ptrResumeExecutor->Enqueue(span);
+    }
+    catch (...)
+    {
+        // batches already wrapped resume inline when destroyed, the rest is resumed here.
+        CYSharedResumeFunctor(pRest, nRest)();
+    }
+
+    objFirstBatch();
+}
+
 void CYSharedResultStateBase::Wait() noexcept
 {
     if (Status() == EResultStatus::STATUS_RESULT_IDLE)
@@ -0,0 +1,94 @@
+#include "CYCommon/Common/Exception/CYException.hpp"
+
+#include "CYCoroutine/Threads/CYAsyncBarrier.hpp"
+
+#include <stdexcept>
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+/*
+    CYAsyncBarrierAwaiter
+*/
+CYAsyncBarrierAwaiter::CYAsyncBarrierAwaiter(CYAsyncBarrierBase& parent, SharePtr<CYExecutor> ptrResumeExecutor) noexcept
+    : CYAsyncWaitNode(std::move(ptrResumeExecutor))
+    , m_parent(parent)
+{
+}
+
+bool CYAsyncBarrierAwaiter::await_suspend(coroutine_handle<void> handleCaller) noexcept
+{
+    SetCaller(handleCaller);
+    return m_parent.Arrive(*this);
+}
+
+void CYAsyncBarrierAwaiter::await_resume() const
+{
+    IfTrueThrow(Interrupted(), TEXT("CYResult - associated task was interrupted abnormally"));
+}
+
+/*
+    CYAsyncBarrierBase
+*/
+
+ /*
+  *   every participant pushes itself before counting down, so the last one to count down finds
+  *   the whole phase on the stack. Nobody of the next phase can arrive before it resumes them,
+  *   by then the counter is rewound.
+  */
+
+CYAsyncBarrierBase::CYAsyncBarrierBase(size_t nExpected)
+    : m_nExpected(nExpected)
+    , m_nRemaining(nExpected)
+{
+    if (nExpected == 0)
+    {
+        throw std::invalid_argument("CYAsyncBarrier - expected count is zero.");
+    }
+}
+
+size_t CYAsyncBarrierBase::Expected() const noexcept
+{
+    return m_nExpected;
+}
+
+bool CYAsyncBarrierBase::Arrive(CYAsyncWaitNode& node) noexcept
+{
+    const auto bPushed = m_stackWaiters.Push(node);
+    assert(bPushed);
+    (void)bPushed;
+
+    if (m_nRemaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+    {
+        return true;  // may be resumed already, don't touch node from here on
+    }
+
+    auto pStack = m_stackWaiters.TakeAll();
+
+    // the last one goes on inline, take it out of the phase.
+    auto ppLink = &pStack;
+    while (*ppLink != &node)
+    {
+        assert(*ppLink != nullptr);
+        ppLink = &(*ppLink)->next;
+    }
+
+    *ppLink = node.next;
+
+    CompletePhase();
+    m_nRemaining.store(m_nExpected, std::memory_order_release);
+
+    CYAsyncWaitStack::ResumeAll(pStack);
+    return false;
+}
+
+CYAsyncBarrierAwaiter CYAsyncBarrierBase::ArriveAndWait(SharePtr<CYExecutor> ptrResumeExecutor)
+{
+    if (!static_cast<bool>(ptrResumeExecutor))
+    {
+        throw std::invalid_argument("CYAsyncBarrier::ArriveAndWait() - given resume CYExecutor is null.");
+    }
+
+    return CYAsyncBarrierAwaiter(*this, std::move(ptrResumeExecutor));
+}
+
+CYCOROUTINE_NAMESPACE_END
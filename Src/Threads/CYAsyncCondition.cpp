@@ -1,5 +1,4 @@
 #include "CYCoroutine/CYCoroutineDefine.hpp"
-#include "CYCoroutine/Results/CYResumeOn.hpp"
 #include "CYCoroutine/Threads/CYAsyncCondition.hpp"
 
 CYCOROUTINE_NAMESPACE_BEGIN
@@ -7,9 +6,11 @@ CYCOROUTINE_NAMESPACE_BEGIN
 /*
     CYAWaiter
 */
-CYAWaiter::CYAWaiter(CYAsyncCondition& parent, CScopedAsyncLock& lock) noexcept
+CYAWaiter::CYAWaiter(CYAsyncCondition& parent, CScopedAsyncLock& lock, SharePtr<CYExecutor> ptrResumeExecutor, CYCancellationToken token) noexcept
     : m_parent(parent)
     , m_lock(lock)
+    , m_lockAwaiter(*lock.Mutex(), std::move(ptrResumeExecutor))
+    , m_token(std::move(token))
 {
 }
 
@@ -20,23 +21,71 @@ constexpr bool CYAWaiter::await_ready() const noexcept
 
 void CYAWaiter::await_suspend(coroutine_handle<void> handleCaller)
 {
-    m_handleCaller = handleCaller;
+    m_lockAwaiter.m_handleResume = handleCaller;
 
     UniqueLock lock(m_parent.m_lock);
     m_lock.UnLock();
 
-    m_parent.m_awaiters.PushBack(*this);
+    m_parent.PushBack(*this);
+
+    // registered under the condition lock, so neither a notification nor OnCancel() can take us meanwhile.
+    if (!m_token.Register(*this))
+    {
+        m_parent.Remove(*this);
+        lock.unlock();
+
+        m_bCancelled = true;
+        resume();
+    }
 }
 
-void CYAWaiter::await_resume() const noexcept
+void CYAWaiter::await_resume()
 {
+    m_token.Deregister(*this);
+
+    // releases the lock again and throws if the resume executor dropped us.
+    m_lockAwaiter.await_resume();
+
+    auto& objMutex = m_lockAwaiter.m_parent;
+
+#ifdef CYCOROUTINE_DEBUG_MODE
+    const auto current_count = objMutex.m_nThreadCountInCriticalSection.fetch_add(1, std::memory_order_relaxed);
+    assert(current_count == 0);
+#endif
+
+    CScopedAsyncLock objOwned(objMutex, std::adopt_lock);
+    m_lock.Swap(objOwned);
+
+    if (m_bCancelled)
+    {
+        m_token.ThrowIfCancelled();
+    }
 }
 
 void CYAWaiter::resume() noexcept
 {
-    assert(static_cast<bool>(m_handleCaller));
-    assert(!m_handleCaller.done());
-    m_handleCaller();
+    assert(static_cast<bool>(m_lockAwaiter.m_handleResume));
+    assert(!m_lockAwaiter.m_handleResume.done());
+
+    // wait morphing: queue up on the lock instead of waking up only to contend for it.
+    if (!m_lockAwaiter.m_parent.Enqueue(m_lockAwaiter))
+    {
+        m_lockAwaiter.Resume();  // the lock was free and is ours now
+    }
+}
+
+void CYAWaiter::OnCancel() noexcept
+{
+    {
+        UniqueLock lock(m_parent.m_lock);
+        if (!m_parent.Remove(*this))
+        {
+            return;  // notified already
+        }
+    }
+
+    m_bCancelled = true;
+    resume();
 }
 
 /*
@@ -46,7 +95,7 @@ CYAsyncCondition::~CYAsyncCondition() noexcept
 {
 #ifdef CYCOROUTINE_DEBUG_MODE
     UniqueLock lock(m_lock);
-    assert(m_awaiters.Empty() && "CYAsyncCondition is deleted while being used.");
+    assert(m_pHead == nullptr && "CYAsyncCondition is deleted while being used.");
 #endif
 }
 
@@ -63,24 +112,91 @@ void CYAsyncCondition::VerifyAwaitParams(const SharePtr<CYExecutor>& ptrResumeEx
     }
 }
 
-CYLazyResult<void> CYAsyncCondition::AWaitImpl(SharePtr<CYExecutor> ptrResumeExecutor, CScopedAsyncLock& lock)
+CYLazyResult<void> CYAsyncCondition::AWaitImpl(SharePtr<CYExecutor> ptrResumeExecutor, CScopedAsyncLock& lock, CYCancellationToken token)
 {
-    co_await CYAWaiter(*this, lock);
-    assert(!lock.OwnsLock());
-    co_await ResumeOn(ptrResumeExecutor);  // TODO: optimize this when get_current_executor is available
-    co_await lock.Lock(ptrResumeExecutor);
+    token.ThrowIfCancelled();
+
+    // resumed once on ptrResumeExecutor, already holding the lock again.
+    co_await CYAWaiter(*this, lock, std::move(ptrResumeExecutor), std::move(token));
+    assert(lock.OwnsLock());
 }
 
 CYLazyResult<void> CYAsyncCondition::await(SharePtr<CYExecutor> ptrResumeExecutor, CScopedAsyncLock& lock)
 {
     VerifyAwaitParams(ptrResumeExecutor, lock);
-    return AWaitImpl(std::move(ptrResumeExecutor), lock);
+    return AWaitImpl(std::move(ptrResumeExecutor), lock, {});
+}
+
+CYLazyResult<void> CYAsyncCondition::await(SharePtr<CYExecutor> ptrResumeExecutor, CScopedAsyncLock& lock, CYCancellationToken token)
+{
+    VerifyAwaitParams(ptrResumeExecutor, lock);
+    return AWaitImpl(std::move(ptrResumeExecutor), lock, std::move(token));
+}
+
+void CYAsyncCondition::PushBack(CYAWaiter& awaiter) noexcept
+{
+    assert(!awaiter.queued);
+    awaiter.prev = m_pTail;
+    awaiter.next = nullptr;
+    awaiter.queued = true;
+
+    if (m_pTail != nullptr)
+    {
+        m_pTail->next = &awaiter;
+    }
+    else
+    {
+        m_pHead = &awaiter;
+    }
+
+    m_pTail = &awaiter;
+}
+
+CYAWaiter* CYAsyncCondition::PopFront() noexcept
+{
+    const auto pAwaiter = m_pHead;
+    if (pAwaiter != nullptr)
+    {
+        Remove(*pAwaiter);
+    }
+
+    return pAwaiter;
+}
+
+bool CYAsyncCondition::Remove(CYAWaiter& awaiter) noexcept
+{
+    if (!awaiter.queued)
+    {
+        return false;  // notified already
+    }
+
+    if (awaiter.prev != nullptr)
+    {
+        awaiter.prev->next = awaiter.next;
+    }
+    else
+    {
+        m_pHead = awaiter.next;
+    }
+
+    if (awaiter.next != nullptr)
+    {
+        awaiter.next->prev = awaiter.prev;
+    }
+    else
+    {
+        m_pTail = awaiter.prev;
+    }
+
+    awaiter.prev = awaiter.next = nullptr;
+    awaiter.queued = false;
+    return true;
 }
 
 void CYAsyncCondition::NotifyOne()
 {
     UniqueLock lock(m_lock);
-    const auto awaiter = m_awaiters.PopFront();
+    const auto awaiter = PopFront();
     lock.unlock();
 
     if (awaiter != nullptr)
@@ -92,18 +208,24 @@ void CYAsyncCondition::NotifyOne()
 void CYAsyncCondition::NotifyALL()
 {
     UniqueLock lock(m_lock);
-    auto awaiters = std::move(m_awaiters);
-    lock.unlock();
+    auto pAwaiter = std::exchange(m_pHead, nullptr);
+    m_pTail = nullptr;
 
-    while (true)
+    // the detached waiters are ours once unmarked, a racing OnCancel() leaves them alone.
+    for (auto pNode = pAwaiter; pNode != nullptr; pNode = pNode->next)
     {
-        const auto awaiter = awaiters.PopFront();
-        if (awaiter == nullptr)
-        {
-            return;  // no more awaiters
-        }
+        pNode->queued = false;
+    }
 
-        awaiter->resume();
+    lock.unlock();
+
+    while (pAwaiter != nullptr)
+    {
+        // read the link first, a resumed waiter may be gone right away.
+        const auto pNext = std::exchange(pAwaiter->next, nullptr);
+        pAwaiter->prev = nullptr;
+        pAwaiter->resume();
+        pAwaiter = pNext;
     }
 }
 
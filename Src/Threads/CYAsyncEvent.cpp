@@ -0,0 +1,98 @@
+#include "CYCommon/Common/Exception/CYException.hpp"
+
+#include "CYCoroutine/Threads/CYAsyncEvent.hpp"
+
+#include <stdexcept>
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+/*
+    CYAsyncEventAwaiter
+*/
+CYAsyncEventAwaiter::CYAsyncEventAwaiter(CYAsyncEvent& parent, SharePtr<CYExecutor> ptrResumeExecutor) noexcept
+    : CYAsyncWaitNode(std::move(ptrResumeExecutor))
+    , m_parent(parent)
+{
+}
+
+bool CYAsyncEventAwaiter::await_ready() noexcept
+{
+    if (m_parent.m_eMode == EAsyncEventMode::EVENT_AUTO_RESET)
+    {
+        return m_parent.m_stackWaiters.Reset();
+    }
+
+    return m_parent.m_stackWaiters.Signaled();
+}
+
+bool CYAsyncEventAwaiter::await_suspend(coroutine_handle<void> handleCaller) noexcept
+{
+    SetCaller(handleCaller);
+
+    if (m_parent.m_eMode == EAsyncEventMode::EVENT_AUTO_RESET)
+    {
+        return m_parent.m_stackWaiters.PushOrConsume(*this);
+    }
+
+    return m_parent.m_stackWaiters.Push(*this);
+}
+
+void CYAsyncEventAwaiter::await_resume()
+{
+    if (Interrupted())
+    {
+        if (m_parent.m_eMode == EAsyncEventMode::EVENT_AUTO_RESET)
+        {
+            m_parent.Set();  // the wake-up was meant for somebody who can take it
+        }
+
+        IfTrueThrow(true, TEXT("CYResult - associated task was interrupted abnormally"));
+    }
+}
+
+/*
+    CYAsyncEvent
+*/
+CYAsyncEvent::CYAsyncEvent(EAsyncEventMode eMode, bool bInitiallySet) noexcept
+    : m_eMode(eMode)
+    , m_stackWaiters(bInitiallySet)
+{
+}
+
+void CYAsyncEvent::Set() noexcept
+{
+    if (m_eMode == EAsyncEventMode::EVENT_AUTO_RESET)
+    {
+        m_stackWaiters.SignalOne();
+        return;
+    }
+
+    m_stackWaiters.Signal();
+}
+
+void CYAsyncEvent::Reset() noexcept
+{
+    m_stackWaiters.Reset();
+}
+
+bool CYAsyncEvent::IsSet() const noexcept
+{
+    return m_stackWaiters.Signaled();
+}
+
+EAsyncEventMode CYAsyncEvent::Mode() const noexcept
+{
+    return m_eMode;
+}
+
+CYAsyncEventAwaiter CYAsyncEvent::Wait(SharePtr<CYExecutor> ptrResumeExecutor)
+{
+    if (!static_cast<bool>(ptrResumeExecutor))
+    {
+        throw std::invalid_argument("CYAsyncEvent::Wait() - given resume CYExecutor is null.");
+    }
+
+    return CYAsyncEventAwaiter(*this, std::move(ptrResumeExecutor));
+}
+
+CYCOROUTINE_NAMESPACE_END
@@ -0,0 +1,75 @@
+#include "CYCommon/Common/Exception/CYException.hpp"
+
+#include "CYCoroutine/Threads/CYAsyncLatch.hpp"
+
+#include <stdexcept>
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+/*
+    CYAsyncLatchAwaiter
+*/
+CYAsyncLatchAwaiter::CYAsyncLatchAwaiter(CYAsyncLatch& parent, SharePtr<CYExecutor> ptrResumeExecutor) noexcept
+    : CYAsyncWaitNode(std::move(ptrResumeExecutor))
+    , m_parent(parent)
+{
+}
+
+bool CYAsyncLatchAwaiter::await_ready() const noexcept
+{
+    return m_parent.TryWait();
+}
+
+bool CYAsyncLatchAwaiter::await_suspend(coroutine_handle<void> handleCaller) noexcept
+{
+    SetCaller(handleCaller);
+    return m_parent.m_stackWaiters.Push(*this);
+}
+
+void CYAsyncLatchAwaiter::await_resume() const
+{
+    IfTrueThrow(Interrupted(), TEXT("CYResult - associated task was interrupted abnormally"));
+}
+
+/*
+    CYAsyncLatch
+*/
+CYAsyncLatch::CYAsyncLatch(size_t nExpected) noexcept
+    : m_nRemaining(nExpected)
+    , m_stackWaiters(nExpected == 0)
+{
+}
+
+void CYAsyncLatch::CountDown(size_t nCount)
+{
+    auto nRemaining = m_nRemaining.load(std::memory_order_relaxed);
+    do
+    {
+        if (nCount > nRemaining)
+        {
+            throw std::invalid_argument("CYAsyncLatch::CountDown() - count is greater than the remaining count.");
+        }
+    } while (!m_nRemaining.compare_exchange_weak(nRemaining, nRemaining - nCount, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+    if (nCount != 0 && nRemaining == nCount)
+    {
+        m_stackWaiters.Signal();
+    }
+}
+
+bool CYAsyncLatch::TryWait() const noexcept
+{
+    return m_stackWaiters.Signaled();
+}
+
+CYAsyncLatchAwaiter CYAsyncLatch::Wait(SharePtr<CYExecutor> ptrResumeExecutor)
+{
+    if (!static_cast<bool>(ptrResumeExecutor))
+    {
+        throw std::invalid_argument("CYAsyncLatch::Wait() - given resume CYExecutor is null.");
+    }
+
+    return CYAsyncLatchAwaiter(*this, std::move(ptrResumeExecutor));
+}
+
+CYCOROUTINE_NAMESPACE_END
@@ -1,4 +1,6 @@
-#include "CYCoroutine/Results/CYResumeOn.hpp"
+#include "CYCommon/Common/Exception/CYException.hpp"
+
+#include "CYCoroutine/Results/Impl/CYConsumerContext.hpp"
 #include "CYCoroutine/Threads/CYAsyncLock.hpp"
 
 CYCOROUTINE_NAMESPACE_BEGIN
@@ -6,92 +8,291 @@ CYCOROUTINE_NAMESPACE_BEGIN
 /*
     CAsyncLockAwaiter
 */
-CAsyncLockAwaiter::CAsyncLockAwaiter(CAsyncLock& parent, UniqueLock& lock) noexcept
+CAsyncLockAwaiter::CAsyncLockAwaiter(CAsyncLock& parent, SharePtr<CYExecutor> ptrResumeExecutor) noexcept
     : m_parent(parent)
-    , m_lock(std::move(lock))
+    , m_ptrResumeExecutor(std::move(ptrResumeExecutor))
 {
 }
 
-constexpr bool CAsyncLockAwaiter::await_ready() const noexcept
+bool CAsyncLockAwaiter::await_ready() noexcept
 {
-    return false;
+    return m_parent.TryAcquire();
+}
+
+bool CAsyncLockAwaiter::await_suspend(coroutine_handle<void> hHandle) noexcept
+{
+    assert(static_cast<bool>(hHandle));
+    assert(!hHandle.done());
+    assert(!static_cast<bool>(m_handleResume));
+
+    m_handleResume = hHandle;
+    return m_parent.Enqueue(*this);  // false: the lock got free meanwhile and is ours, go on inline
 }
 
-constexpr void CAsyncLockAwaiter::await_resume() const noexcept
+void CAsyncLockAwaiter::await_resume()
+{
+    CYAwaitViaFunctor::HandBackIfInterrupted(m_bInterrupted, [this] { m_parent.Release(); });
+}
+
+bool CAsyncLockAwaiter::Resume() noexcept
+{
+    assert(static_cast<bool>(m_ptrResumeExecutor));
+
+    CYAwaitViaFunctor::Post(*m_ptrResumeExecutor, m_handleResume, &m_bInterrupted);
+    return true;
+}
+
+/*
+    CAsyncLockTicket
+*/
+
+ /*
+  *   k_nRegistering -> k_nWaiting -> k_nGranted | k_nCancelled
+  *   whoever moves it out of k_nWaiting resumes the coroutine, out of k_nRegistering the
+  *   registering thread goes on inline. The lock queue and the awaiter own a reference each.
+  */
+class CAsyncLockTicket final : public CAsyncLockAwaiter, private CYCancellationCallback
+{
+public:
+    CAsyncLockTicket(CAsyncLock& parent, SharePtr<CYExecutor> ptrResumeExecutor, coroutine_handle<void> handleResume) noexcept
+        : CAsyncLockAwaiter(parent, std::move(ptrResumeExecutor))
+    {
+        m_handleResume = handleResume;
+    }
+
+    // false: already granted or cancelled, the registering coroutine doesn't suspend.
+    bool Arm(const CYCancellationToken& token) noexcept
+    {
+        if (!token.Register(*this))
+        {
+            auto nExpected = k_nRegistering;
+            m_nState.compare_exchange_strong(nExpected, k_nCancelled, std::memory_order_acq_rel, std::memory_order_acquire);
+        }
+
+        auto nExpected = k_nRegistering;
+        return m_nState.compare_exchange_strong(nExpected, k_nWaiting, std::memory_order_acq_rel, std::memory_order_acquire);
+    }
+
+    void Disarm(const CYCancellationToken& token) noexcept
+    {
+        token.Deregister(*this);
+    }
+
+    bool Granted() const noexcept
+    {
+        return m_nState.load(std::memory_order_acquire) == k_nGranted;
+    }
+
+    bool Interrupted() const noexcept
+    {
+        return m_bInterrupted;
+    }
+
+    bool Resume() noexcept override
+    {
+        auto nState = m_nState.load(std::memory_order_acquire);
+        while (nState != k_nCancelled)
+        {
+            if (m_nState.compare_exchange_weak(nState, k_nGranted, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                if (nState == k_nWaiting)
+                {
+                    CAsyncLockAwaiter::Resume();
+                }
+
+                Unref();
+                return true;
+            }
+        }
+
+        Unref();
+        return false;
+    }
+
+    void Unref() noexcept
+    {
+        if (m_nRefs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            delete this;
+        }
+    }
+
+private:
+    void OnCancel() noexcept override
+    {
+        auto nState = m_nState.load(std::memory_order_acquire);
+        while (nState == k_nRegistering || nState == k_nWaiting)
+        {
+            if (m_nState.compare_exchange_weak(nState, k_nCancelled, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                if (nState == k_nWaiting)
+                {
+                    CAsyncLockAwaiter::Resume();
+                }
+
+                return;
+            }
+        }
+    }
+
+private:
+    static constexpr int k_nRegistering = 0;
+    static constexpr int k_nWaiting = 1;
+    static constexpr int k_nGranted = 2;
+    static constexpr int k_nCancelled = 3;
+
+    std::atomic_int m_nState{ k_nRegistering };
+    std::atomic_int m_nRefs{ 2 };
+};
+
+/*
+    CAsyncLockCancellableAwaiter
+*/
+CAsyncLockCancellableAwaiter::CAsyncLockCancellableAwaiter(CAsyncLock& parent, SharePtr<CYExecutor> ptrResumeExecutor, CYCancellationToken token) noexcept
+    : m_parent(parent)
+    , m_ptrResumeExecutor(std::move(ptrResumeExecutor))
+    , m_token(std::move(token))
 {
 }
 
-void CAsyncLockAwaiter::await_suspend(coroutine_handle<void> hHandle)
+bool CAsyncLockCancellableAwaiter::await_ready() noexcept
+{
+    if (m_token.IsCancelled())
+    {
+        return true;
+    }
+
+    m_bAcquired = m_parent.TryAcquire();
+    return m_bAcquired;
+}
+
+bool CAsyncLockCancellableAwaiter::await_suspend(coroutine_handle<void> hHandle)
 {
     assert(static_cast<bool>(hHandle));
     assert(!hHandle.done());
-    assert(!static_cast<bool>(m_handleResume));
-    assert(m_lock.owns_lock());
 
-    m_handleResume = hHandle;
-    m_parent.m_lstAwaiters.PushBack(*this);
+    auto pTicket = new CAsyncLockTicket(m_parent, m_ptrResumeExecutor, hHandle);
+    if (!m_parent.Enqueue(*pTicket))
+    {
+        delete pTicket;  // the lock got free meanwhile and is ours
+        m_bAcquired = true;
+        return false;
+    }
 
-    auto lock = std::move(m_lock);  // will unlock underlying lock
+    m_pTicket = pTicket;
+    return pTicket->Arm(m_token);
 }
 
-void CAsyncLockAwaiter::retry() noexcept
+void CAsyncLockCancellableAwaiter::await_resume()
 {
-    m_handleResume.resume();
+    if (const auto pTicket = std::exchange(m_pTicket, nullptr))
+    {
+        pTicket->Disarm(m_token);
+        m_bAcquired = pTicket->Granted();
+
+        const auto bInterrupted = pTicket->Interrupted();
+        pTicket->Unref();
+
+        CYAwaitViaFunctor::HandBackIfInterrupted(m_bAcquired && bInterrupted, [this] { m_parent.Release(); });
+    }
+
+    if (!m_bAcquired)
+    {
+        m_token.ThrowIfCancelled();
+    }
 }
 
 /*
     CAsyncLock
 */
 
+ /*
+  *   NotLockedConstant() <-> nullptr <-> waiter stack (newest first)
+  *   locking CASes NotLockedConstant() -> nullptr or pushes onto the stack, the holder drains the
+  *   stack into m_pWaiters and hands the lock to the oldest waiter without ever unlocking it.
+  */
+
+CAsyncLockAwaiter* CAsyncLock::NotLockedConstant() noexcept
+{
+    return reinterpret_cast<CAsyncLockAwaiter*>(1);
+}
+
 CAsyncLock::~CAsyncLock() noexcept
 {
 #ifdef CYCOROUTINE_DEBUG_MODE
-    UniqueLock lock(m_mutexAwaiter);
-    assert(!m_bLocked && "CAsyncLock is dstroyed while it's locked.");
+    assert(m_pState.load(std::memory_order_acquire) == NotLockedConstant() && "CAsyncLock is dstroyed while it's locked.");
 #endif
 }
 
-CYLazyResult<CScopedAsyncLock> CAsyncLock::LockImpl(SharePtr<CYExecutor> ptrResumeExecutor, bool bWithRAIIGuard)
+bool CAsyncLock::TryAcquire() noexcept
 {
-    auto resume_synchronously = true;  // indicates if the locking coroutine managed to lock the lock on first attempt
+    auto pExpected = NotLockedConstant();
+    return m_pState.compare_exchange_strong(pExpected, nullptr, std::memory_order_acquire, std::memory_order_relaxed);
+}
 
+bool CAsyncLock::Enqueue(CAsyncLockAwaiter& awaiter) noexcept
+{
+    auto pState = m_pState.load(std::memory_order_relaxed);
     while (true)
     {
-        UniqueLock lock(m_mutexAwaiter);
-        if (!m_bLocked)
+        if (pState == NotLockedConstant())
         {
-            m_bLocked = true;
-            lock.unlock();
-            break;
-        }
+            if (m_pState.compare_exchange_weak(pState, nullptr, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                return false;
+            }
 
-        co_await CAsyncLockAwaiter(*this, lock);
+            continue;
+        }
 
-        resume_synchronously = false;  // if we haven't managed to lock the lock on first attempt, we need to resume using ptrResumeExecutor
+        awaiter.next = pState;
+        if (m_pState.compare_exchange_weak(pState, &awaiter, std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+            return true;
+        }
     }
+}
 
-    if (!resume_synchronously)
+void CAsyncLock::Release() noexcept
+{
+    while (true)
     {
-        try
+        if (m_pWaiters == nullptr)
         {
-            co_await ResumeOn(ptrResumeExecutor);
-        }
-        catch (...)
-        {
-            UniqueLock lock(m_mutexAwaiter);
-            assert(m_bLocked);
-            m_bLocked = false;
-            const auto awaiter = m_lstAwaiters.PopFront();
-            lock.unlock();
-
-            if (awaiter != nullptr)
+            auto pExpected = static_cast<CAsyncLockAwaiter*>(nullptr);
+            if (m_pState.compare_exchange_strong(pExpected, NotLockedConstant(), std::memory_order_release, std::memory_order_relaxed))
             {
-                awaiter->retry();
+                return;
             }
 
-            throw;
+            // new waiters arrived, take the whole stack and put it in arrival order.
+            auto pStack = m_pState.exchange(nullptr, std::memory_order_acquire);
+            assert(pStack != nullptr && pStack != NotLockedConstant());
+
+            do
+            {
+                auto pNext = pStack->next;
+                pStack->next = m_pWaiters;
+                m_pWaiters = pStack;
+                pStack = pNext;
+            } while (pStack != nullptr);
+        }
+
+        // the lock stays locked, ownership goes straight to the oldest waiter that still wants it.
+        const auto awaiter = m_pWaiters;
+        m_pWaiters = awaiter->next;
+        if (awaiter->Resume())
+        {
+            return;
         }
     }
+}
+
+CYLazyResult<CScopedAsyncLock> CAsyncLock::LockImpl(SharePtr<CYExecutor> ptrResumeExecutor, bool bWithRAIIGuard)
+{
+    // an uncontended lock is taken in await_ready and resumes synchronously, a contended one
+    // is scheduled once on ptrResumeExecutor by the thread handing the lock over.
+    co_await CAsyncLockAwaiter(*this, std::move(ptrResumeExecutor));
 
 #ifdef CYCOROUTINE_DEBUG_MODE
     const auto current_count = m_nThreadCountInCriticalSection.fetch_add(1, std::memory_order_relaxed);
@@ -106,6 +307,18 @@ CYLazyResult<CScopedAsyncLock> CAsyncLock::LockImpl(SharePtr<CYExecutor> ptrResu
     co_return CScopedAsyncLock(*this, std::defer_lock);
 }
 
+CYLazyResult<CScopedAsyncLock> CAsyncLock::LockImpl(SharePtr<CYExecutor> ptrResumeExecutor, CYCancellationToken token)
+{
+    co_await CAsyncLockCancellableAwaiter(*this, std::move(ptrResumeExecutor), std::move(token));
+
+#ifdef CYCOROUTINE_DEBUG_MODE
+    const auto current_count = m_nThreadCountInCriticalSection.fetch_add(1, std::memory_order_relaxed);
+    assert(current_count == 0);
+#endif
+
+    co_return CScopedAsyncLock(*this, std::adopt_lock);
+}
+
 CYLazyResult<CScopedAsyncLock> CAsyncLock::Lock(SharePtr<CYExecutor> ptrResumeExecutor)
 {
     if (!static_cast<bool>(ptrResumeExecutor))
@@ -116,22 +329,20 @@ CYLazyResult<CScopedAsyncLock> CAsyncLock::Lock(SharePtr<CYExecutor> ptrResumeEx
     return LockImpl(std::move(ptrResumeExecutor), true);
 }
 
-CYLazyResult<bool> CAsyncLock::TryLock()
+CYLazyResult<CScopedAsyncLock> CAsyncLock::Lock(SharePtr<CYExecutor> ptrResumeExecutor, CYCancellationToken token)
 {
-    auto bRet = false;
-
-    UniqueLock lock(m_mutexAwaiter);
-    if (!m_bLocked)
-    {
-        m_bLocked = true;
-        lock.unlock();
-        bRet = true;
-    }
-    else
+    if (!static_cast<bool>(ptrResumeExecutor))
     {
-        lock.unlock();
+        throw std::invalid_argument("CAsyncLock::lock() - given resume CYExecutor is null.");
     }
 
+    return LockImpl(std::move(ptrResumeExecutor), std::move(token));
+}
+
+CYLazyResult<bool> CAsyncLock::TryLock()
+{
+    const auto bRet = TryAcquire();
+
 #ifdef CYCOROUTINE_DEBUG_MODE
     if (bRet)
     {
@@ -145,27 +356,17 @@ CYLazyResult<bool> CAsyncLock::TryLock()
 
 void CAsyncLock::UnLock()
 {
-    UniqueLock lock(m_mutexAwaiter);
-    if (!m_bLocked)
+    if (m_pState.load(std::memory_order_relaxed) == NotLockedConstant())
     {  // trying to unlocked non-owned mutex
-        lock.unlock();
         throw std::system_error(static_cast<int>(std::errc::operation_not_permitted), std::system_category(), "CAsyncLock::UnLock() - trying to unlock an unowned lock.");
     }
 
-    m_bLocked = false;
-
 #ifdef CYCOROUTINE_DEBUG_MODE
     const auto current_count = m_nThreadCountInCriticalSection.fetch_sub(1, std::memory_order_relaxed);
     assert(current_count == 1);
 #endif
 
-    const auto awaiter = m_lstAwaiters.PopFront();
-    lock.unlock();
-
-    if (awaiter != nullptr)
-    {
-        awaiter->retry();
-    }
+    Release();
 }
 
 /*
@@ -0,0 +1,200 @@
+#include "CYCommon/Common/Exception/CYException.hpp"
+
+#include "CYCoroutine/Results/Impl/CYConsumerContext.hpp"
+#include "CYCoroutine/Threads/CYAsyncSemaphore.hpp"
+
+#include <stdexcept>
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+/*
+    CYAsyncSemaphoreAwaiter
+*/
+CYAsyncSemaphoreAwaiter::CYAsyncSemaphoreAwaiter(CYAsyncSemaphore& parent, size_t nCount, SharePtr<CYExecutor> ptrResumeExecutor) noexcept
+    : CYAsyncWaitNode(std::move(ptrResumeExecutor))
+    , m_parent(parent)
+    , m_nCount(nCount)
+{
+}
+
+bool CYAsyncSemaphoreAwaiter::await_ready() noexcept
+{
+    return m_parent.TryAcquire(m_nCount);
+}
+
+bool CYAsyncSemaphoreAwaiter::await_suspend(coroutine_handle<void> hHandle)
+{
+    SetCaller(hHandle);
+    return m_parent.Enqueue(*this);  // false: acquired under the waiter mutex, go on inline
+}
+
+void CYAsyncSemaphoreAwaiter::await_resume()
+{
+    CYAwaitViaFunctor::HandBackIfInterrupted(Interrupted(), [this] { m_parent.Release(m_nCount); });
+}
+
+/*
+    CYAsyncSemaphore
+*/
+
+ /*
+  *   fast paths:  while k_nWaiters is clear, Acquire and Release CAS the permit count.
+  *   slow path:   k_nWaiters is set under m_mutexWaiters together with queuing, from then on
+  *                every release goes through HandOver(), which is the only place permits
+  *                move while somebody waits. It serves the queue head first, a large request
+  *                at the head holds back smaller ones behind it.
+  */
+
+CYAsyncSemaphore::CYAsyncSemaphore(size_t nInitialCount) noexcept
+    : m_nState(static_cast<uint64_t>(nInitialCount) * k_nPermit)
+{
+}
+
+CYAsyncSemaphore::~CYAsyncSemaphore() noexcept
+{
+#ifdef CYCOROUTINE_DEBUG_MODE
+    assert(m_pHead == nullptr && "CYAsyncSemaphore is destroyed while coroutines still wait on it.");
+#endif
+}
+
+size_t CYAsyncSemaphore::Available() const noexcept
+{
+    return static_cast<size_t>(m_nState.load(std::memory_order_relaxed) / k_nPermit);
+}
+
+CYAsyncSemaphoreAwaiter CYAsyncSemaphore::Acquire(size_t nCount, SharePtr<CYExecutor> ptrResumeExecutor)
+{
+    if (!static_cast<bool>(ptrResumeExecutor))
+    {
+        throw std::invalid_argument("CYAsyncSemaphore::Acquire() - given resume CYExecutor is null.");
+    }
+
+    return CYAsyncSemaphoreAwaiter(*this, nCount, std::move(ptrResumeExecutor));
+}
+
+bool CYAsyncSemaphore::TryAcquire(size_t nCount) noexcept
+{
+    const auto nRequired = static_cast<uint64_t>(nCount) * k_nPermit;
+
+    auto nState = m_nState.load(std::memory_order_relaxed);
+    while ((nState & k_nWaiters) == 0 && nState >= nRequired)
+    {
+        if (m_nState.compare_exchange_weak(nState, nState - nRequired, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CYAsyncSemaphore::Release(size_t nCount)
+{
+    if (nCount == 0)
+    {
+        return;
+    }
+
+    const auto nReleased = static_cast<uint64_t>(nCount) * k_nPermit;
+
+    auto nState = m_nState.load(std::memory_order_relaxed);
+    while ((nState & k_nWaiters) == 0)
+    {
+        if (nState + nReleased < nState)
+        {
+            throw std::overflow_error("CYAsyncSemaphore::Release() - permit count overflow.");
+        }
+
+        if (m_nState.compare_exchange_weak(nState, nState + nReleased, std::memory_order_release, std::memory_order_relaxed))
+        {
+            return;
+        }
+    }
+
+    HandOver(nCount);
+}
+
+bool CYAsyncSemaphore::Enqueue(CYAsyncSemaphoreAwaiter& awaiter)
+{
+    const auto nRequired = static_cast<uint64_t>(awaiter.m_nCount) * k_nPermit;
+
+    std::lock_guard<std::mutex> lock(m_mutexWaiters);
+
+    auto nState = m_nState.load(std::memory_order_relaxed);
+    while (true)
+    {
+        // permits released since the fast path failed, only taken if nobody queued first.
+        if (m_pHead == nullptr && nState >= nRequired)
+        {
+            if (m_nState.compare_exchange_weak(nState, nState - nRequired, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                return false;
+            }
+
+            continue;
+        }
+
+        if (m_nState.compare_exchange_weak(nState, nState | k_nWaiters, std::memory_order_relaxed, std::memory_order_relaxed))
+        {
+            break;
+        }
+    }
+
+    awaiter.next = nullptr;
+    if (m_pTail == nullptr)
+    {
+        m_pHead = &awaiter;
+    }
+    else
+    {
+        m_pTail->next = &awaiter;
+    }
+
+    m_pTail = &awaiter;
+    return true;
+}
+
+void CYAsyncSemaphore::HandOver(size_t nCount) noexcept
+{
+    CYAsyncSemaphoreAwaiter* pAdmitted = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutexWaiters);
+
+        // k_nWaiters is set, nobody but us touches the state until we store it back.
+        auto nPermits = m_nState.load(std::memory_order_relaxed) / k_nPermit + nCount;
+
+        if (m_pHead != nullptr && m_pHead->m_nCount <= nPermits)
+        {
+            pAdmitted = m_pHead;
+
+            auto pLast = m_pHead;
+            nPermits -= pLast->m_nCount;
+
+            while (Next(*pLast) != nullptr && Next(*pLast)->m_nCount <= nPermits)
+            {
+                pLast = Next(*pLast);
+                nPermits -= pLast->m_nCount;
+            }
+
+            m_pHead = Next(*pLast);
+            pLast->next = nullptr;
+            if (m_pHead == nullptr)
+            {
+                m_pTail = nullptr;
+            }
+        }
+
+        m_nState.store(nPermits * k_nPermit | (m_pHead != nullptr ? k_nWaiters : 0), std::memory_order_release);
+    }
+
+    // the admitted waiters already own their permits.
+    CYAsyncWaitStack::ResumeInOrder(pAdmitted);
+}
+
+CYAsyncSemaphoreAwaiter* CYAsyncSemaphore::Next(const CYAsyncSemaphoreAwaiter& awaiter) noexcept
+{
+    return static_cast<CYAsyncSemaphoreAwaiter*>(awaiter.next);
+}
+
+CYCOROUTINE_NAMESPACE_END
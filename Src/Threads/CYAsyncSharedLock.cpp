@@ -0,0 +1,244 @@
+#include "CYCommon/Common/Exception/CYException.hpp"
+
+#include "CYCoroutine/Results/Impl/CYConsumerContext.hpp"
+#include "CYCoroutine/Threads/CYAsyncSharedLock.hpp"
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+/*
+    CYAsyncSharedLockAwaiter
+*/
+CYAsyncSharedLockAwaiter::CYAsyncSharedLockAwaiter(CYAsyncSharedLock& parent, SharePtr<CYExecutor> ptrResumeExecutor, bool bShared) noexcept
+    : m_parent(parent)
+    , m_ptrResumeExecutor(std::move(ptrResumeExecutor))
+    , m_bShared(bShared)
+{
+}
+
+bool CYAsyncSharedLockAwaiter::await_ready() noexcept
+{
+    return m_bShared ? m_parent.TryLockShared() : m_parent.TryLock();
+}
+
+bool CYAsyncSharedLockAwaiter::await_suspend(coroutine_handle<void> hHandle)
+{
+    assert(static_cast<bool>(hHandle));
+    assert(!hHandle.done());
+
+    m_handleResume = hHandle;
+    return m_parent.Enqueue(*this);  // false: acquired under the waiter mutex, go on inline
+}
+
+void CYAsyncSharedLockAwaiter::await_resume()
+{
+    CYAwaitViaFunctor::HandBackIfInterrupted(m_bInterrupted, [this] { m_parent.Release(m_bShared); });
+}
+
+void CYAsyncSharedLockAwaiter::Resume() noexcept
+{
+    assert(static_cast<bool>(m_ptrResumeExecutor));
+
+    CYAwaitViaFunctor::Post(*m_ptrResumeExecutor, m_handleResume, &m_bInterrupted);
+}
+
+/*
+    CYAsyncSharedLock
+*/
+
+ /*
+  *   fast paths:  readers CAS count + 1 while neither k_nWriter nor k_nWaiters is set,
+  *                a writer CAS 0 -> k_nWriter, the releases undo that.
+  *   slow path:   k_nWaiters is set under m_mutexWaiters together with queuing, which sends
+  *                the last releasing holder to HandOver(), the only place the lock changes
+  *                hands while somebody waits.
+  */
+
+CYAsyncSharedLock::CYAsyncSharedLock(EAsyncSharedLockPolicy ePolicy) noexcept
+    : m_ePolicy(ePolicy)
+{
+}
+
+CYAsyncSharedLock::~CYAsyncSharedLock() noexcept
+{
+#ifdef CYCOROUTINE_DEBUG_MODE
+    assert(m_nState.load(std::memory_order_acquire) == 0 && "CYAsyncSharedLock is destroyed while it's locked.");
+#endif
+}
+
+EAsyncSharedLockPolicy CYAsyncSharedLock::Policy() const noexcept
+{
+    return m_ePolicy;
+}
+
+bool CYAsyncSharedLock::TryLockShared() noexcept
+{
+    auto nState = m_nState.load(std::memory_order_relaxed);
+    while ((nState & (k_nWriter | k_nWaiters)) == 0)
+    {
+        if (m_nState.compare_exchange_weak(nState, nState + k_nReader, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool CYAsyncSharedLock::TryLock() noexcept
+{
+    auto nExpected = static_cast<uint64_t>(0);
+    return m_nState.compare_exchange_strong(nExpected, k_nWriter, std::memory_order_acquire, std::memory_order_relaxed);
+}
+
+bool CYAsyncSharedLock::Enqueue(CYAsyncSharedLockAwaiter& awaiter)
+{
+    std::lock_guard<std::mutex> lock(m_mutexWaiters);
+
+    auto nState = m_nState.load(std::memory_order_relaxed);
+    while (true)
+    {
+        // queued waiters go first, a newcomer only gets in if it wouldn't overtake anyone.
+        const auto bFree = awaiter.m_bShared ?
+            (nState & k_nWriter) == 0 && m_lstWriters.Empty() :
+            (nState & ~k_nWaiters) == 0 && m_lstWriters.Empty() && m_lstReaders.Empty();
+
+        if (bFree)
+        {
+            const auto nLocked = awaiter.m_bShared ? nState + k_nReader : nState | k_nWriter;
+            if (m_nState.compare_exchange_weak(nState, nLocked, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                return false;
+            }
+
+            continue;
+        }
+
+        // the holders seen here are still holding, the last of them will see k_nWaiters.
+        if (m_nState.compare_exchange_weak(nState, nState | k_nWaiters, std::memory_order_relaxed, std::memory_order_relaxed))
+        {
+            break;
+        }
+    }
+
+    (awaiter.m_bShared ? m_lstReaders : m_lstWriters).PushBack(awaiter);
+    return true;
+}
+
+void CYAsyncSharedLock::Release(bool bShared) noexcept
+{
+    if (bShared)
+    {
+        const auto nState = m_nState.fetch_sub(k_nReader, std::memory_order_release);
+        assert(nState >= k_nReader && (nState & k_nWriter) == 0);
+
+        if (nState != (k_nReader | k_nWaiters))
+        {
+            return;  // other readers still hold it, or nobody waits
+        }
+    }
+    else
+    {
+        auto nExpected = k_nWriter;
+        if (m_nState.compare_exchange_strong(nExpected, 0, std::memory_order_release, std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        assert(nExpected == (k_nWriter | k_nWaiters));
+    }
+
+    HandOver(!bShared);
+}
+
+void CYAsyncSharedLock::HandOver(bool bWriterReleased) noexcept
+{
+    CYList<CYAsyncSharedLockAwaiter> lstAdmitted;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutexWaiters);
+
+        const auto bReadPhase = bWriterReleased && m_ePolicy == EAsyncSharedLockPolicy::POLICY_PHASE_FAIR && !m_lstReaders.Empty();
+
+        uint64_t nState = 0;
+        if (!m_lstWriters.Empty() && !bReadPhase)
+        {
+            lstAdmitted.PushBack(*m_lstWriters.PopFront());
+            nState = k_nWriter;
+        }
+        else
+        {
+            while (const auto pReader = m_lstReaders.PopFront())
+            {
+                lstAdmitted.PushBack(*pReader);
+                nState += k_nReader;
+            }
+        }
+
+        if (!m_lstReaders.Empty() || !m_lstWriters.Empty())
+        {
+            nState |= k_nWaiters;
+        }
+
+        m_nState.store(nState, std::memory_order_release);
+    }
+
+    // the admitted waiters already own the lock, each is scheduled exactly once.
+    while (const auto pAwaiter = lstAdmitted.PopFront())
+    {
+        pAwaiter->Resume();
+    }
+}
+
+CYLazyResult<CYScopedAsyncSharedLock> CYAsyncSharedLock::LockSharedImpl(SharePtr<CYExecutor> ptrResumeExecutor)
+{
+    co_await CYAsyncSharedLockAwaiter(*this, std::move(ptrResumeExecutor), true);
+    co_return CYScopedAsyncSharedLock(*this, std::adopt_lock);
+}
+
+CYLazyResult<CYScopedAsyncUniqueLock> CYAsyncSharedLock::LockImpl(SharePtr<CYExecutor> ptrResumeExecutor)
+{
+    co_await CYAsyncSharedLockAwaiter(*this, std::move(ptrResumeExecutor), false);
+    co_return CYScopedAsyncUniqueLock(*this, std::adopt_lock);
+}
+
+CYLazyResult<CYScopedAsyncSharedLock> CYAsyncSharedLock::LockShared(SharePtr<CYExecutor> ptrResumeExecutor)
+{
+    if (!static_cast<bool>(ptrResumeExecutor))
+    {
+        throw std::invalid_argument("CYAsyncSharedLock::LockShared() - given resume CYExecutor is null.");
+    }
+
+    return LockSharedImpl(std::move(ptrResumeExecutor));
+}
+
+CYLazyResult<CYScopedAsyncUniqueLock> CYAsyncSharedLock::Lock(SharePtr<CYExecutor> ptrResumeExecutor)
+{
+    if (!static_cast<bool>(ptrResumeExecutor))
+    {
+        throw std::invalid_argument("CYAsyncSharedLock::Lock() - given resume CYExecutor is null.");
+    }
+
+    return LockImpl(std::move(ptrResumeExecutor));
+}
+
+void CYAsyncSharedLock::UnLockShared()
+{
+    if ((m_nState.load(std::memory_order_relaxed) & ~(k_nWriter | k_nWaiters)) == 0)
+    {
+        throw std::system_error(static_cast<int>(std::errc::operation_not_permitted), std::system_category(), "CYAsyncSharedLock::UnLockShared() - trying to unlock an unowned lock.");
+    }
+
+    Release(true);
+}
+
+void CYAsyncSharedLock::UnLock()
+{
+    if ((m_nState.load(std::memory_order_relaxed) & k_nWriter) == 0)
+    {
+        throw std::system_error(static_cast<int>(std::errc::operation_not_permitted), std::system_category(), "CYAsyncSharedLock::UnLock() - trying to unlock an unowned lock.");
+    }
+
+    Release(false);
+}
+
+CYCOROUTINE_NAMESPACE_END
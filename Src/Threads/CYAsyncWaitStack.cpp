@@ -0,0 +1,213 @@
+#include "CYCoroutine/Results/Impl/CYConsumerContext.hpp"
+#include "CYCoroutine/Threads/CYAsyncWaitStack.hpp"
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+/*
+    CYAsyncWaitNode
+*/
+CYAsyncWaitNode::CYAsyncWaitNode(SharePtr<CYExecutor> ptrResumeExecutor) noexcept
+    : m_ptrResumeExecutor(std::move(ptrResumeExecutor))
+{
+}
+
+void CYAsyncWaitNode::SetCaller(coroutine_handle<void> handleCaller) noexcept
+{
+    assert(static_cast<bool>(handleCaller));
+    assert(!handleCaller.done());
+    m_handleResume = handleCaller;
+}
+
+bool CYAsyncWaitNode::Interrupted() const noexcept
+{
+    return m_bInterrupted;
+}
+
+/*
+    CYAsyncWaitStack
+*/
+CYAsyncWaitNode* CYAsyncWaitStack::SignaledConstant() noexcept
+{
+    return reinterpret_cast<CYAsyncWaitNode*>(-1);
+}
+
+CYAsyncWaitStack::CYAsyncWaitStack(bool bSignaled) noexcept
+    : m_pHead(bSignaled ? SignaledConstant() : nullptr)
+{
+}
+
+CYAsyncWaitStack::~CYAsyncWaitStack() noexcept
+{
+#ifdef CYCOROUTINE_DEBUG_MODE
+    const auto pHead = m_pHead.load(std::memory_order_acquire);
+    assert((pHead == nullptr || pHead == SignaledConstant()) && m_pReady == nullptr && "CYAsyncWaitStack is destroyed while coroutines still wait on it.");
+#endif
+}
+
+bool CYAsyncWaitStack::Signaled() const noexcept
+{
+    return m_pHead.load(std::memory_order_acquire) == SignaledConstant();
+}
+
+bool CYAsyncWaitStack::Push(CYAsyncWaitNode& node) noexcept
+{
+    auto pHead = m_pHead.load(std::memory_order_acquire);
+    while (true)
+    {
+        if (pHead == SignaledConstant())
+        {
+            return false;
+        }
+
+        node.next = pHead;
+        if (m_pHead.compare_exchange_weak(pHead, &node, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            return true;
+        }
+    }
+}
+
+bool CYAsyncWaitStack::PushOrConsume(CYAsyncWaitNode& node) noexcept
+{
+    auto pHead = m_pHead.load(std::memory_order_acquire);
+    while (true)
+    {
+        if (pHead == SignaledConstant())
+        {
+            if (m_pHead.compare_exchange_weak(pHead, nullptr, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                return false;
+            }
+
+            continue;
+        }
+
+        node.next = pHead;
+        if (m_pHead.compare_exchange_weak(pHead, &node, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            return true;
+        }
+    }
+}
+
+void CYAsyncWaitStack::Signal() noexcept
+{
+    const auto pStack = m_pHead.exchange(SignaledConstant(), std::memory_order_acq_rel);
+    if (pStack != SignaledConstant())
+    {
+        ResumeAll(pStack);
+    }
+}
+
+void CYAsyncWaitStack::SignalOne() noexcept
+{
+    CYAsyncWaitNode* pNode = nullptr;
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutexReady);
+        if (m_pReady == nullptr && !TakeReady())
+        {
+            return;
+        }
+
+        pNode = m_pReady;
+        m_pReady = std::exchange(pNode->next, nullptr);
+    }
+
+    Resume(*pNode);
+}
+
+bool CYAsyncWaitStack::TakeReady() noexcept
+{
+    auto pStack = m_pHead.load(std::memory_order_acquire);
+    while (true)
+    {
+        if (pStack == SignaledConstant())
+        {
+            return false;
+        }
+
+        const auto pNew = pStack == nullptr ? SignaledConstant() : nullptr;
+        if (m_pHead.compare_exchange_weak(pStack, pNew, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            break;
+        }
+    }
+
+    // newest first on the stack, the FIFO hands them out oldest first.
+    while (pStack != nullptr)
+    {
+        const auto pNext = pStack->next;
+        pStack->next = m_pReady;
+        m_pReady = pStack;
+        pStack = pNext;
+    }
+
+    return m_pReady != nullptr;
+}
+
+bool CYAsyncWaitStack::Reset() noexcept
+{
+    auto pExpected = SignaledConstant();
+    return m_pHead.compare_exchange_strong(pExpected, nullptr, std::memory_order_acq_rel, std::memory_order_relaxed);
+}
+
+CYAsyncWaitNode* CYAsyncWaitStack::TakeAll() noexcept
+{
+    const auto pStack = m_pHead.exchange(nullptr, std::memory_order_acq_rel);
+    assert(pStack != SignaledConstant());
+    return pStack;
+}
+
+void CYAsyncWaitStack::Resume(CYAsyncWaitNode& node) noexcept
+{
+    assert(static_cast<bool>(node.m_ptrResumeExecutor));
+
+    CYAwaitViaFunctor::Post(*node.m_ptrResumeExecutor, node.m_handleResume, &node.m_bInterrupted);
+}
+
+void CYAsyncWaitStack::ResumeAll(CYAsyncWaitNode* pStack) noexcept
+{
+    // newest first on the stack, resumed in arrival order.
+    CYAsyncWaitNode* pNode = nullptr;
+    while (pStack != nullptr)
+    {
+        const auto pNext = pStack->next;
+        pStack->next = pNode;
+        pNode = pStack;
+        pStack = pNext;
+    }
+
+    ResumeInOrder(pNode);
+}
+
+void CYAsyncWaitStack::ResumeInOrder(CYAsyncWaitNode* pNode) noexcept
+{
+    while (pNode != nullptr)
+    {
+        const auto ptrExecutor = pNode->m_ptrResumeExecutor;
+        assert(static_cast<bool>(ptrExecutor));
+
+        CYTask arrBatch[k_nResumeBatch];
+        size_t nBatchSize = 0;
+
+        while (pNode != nullptr && nBatchSize < k_nResumeBatch && pNode->m_ptrResumeExecutor == ptrExecutor)
+        {
+            // read the link first, a waiter may be gone as soon as its batch is enqueued.
+            const auto pNext = std::exchange(pNode->next, nullptr);
+            arrBatch[nBatchSize++] = CYAwaitViaFunctor{ pNode->m_handleResume, &pNode->m_bInterrupted };
+            pNode = pNext;
+        }
+
+        try
+        {
+            ptrExecutor->Enqueue(std::span<CYTask>(arrBatch, nBatchSize));
+        }
+        catch (...)
+        {
+            // the tasks left in arrBatch resume their coroutines with m_bInterrupted set once destroyed.
+        }
+    }
+}
+
+CYCOROUTINE_NAMESPACE_END
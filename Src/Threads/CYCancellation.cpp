@@ -0,0 +1,197 @@
+#include "CYCoroutine/Threads/CYCancellation.hpp"
+
+#include <system_error>
+
+#include <cassert>
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+/*
+    CYCancellationState
+*/
+CYCancellationState::~CYCancellationState() noexcept
+{
+#ifdef CYCOROUTINE_DEBUG_MODE
+    assert(m_pHead == nullptr && "CYCancellationState is destroyed while callbacks are still registered.");
+#endif
+}
+
+bool CYCancellationState::Cancelled() const noexcept
+{
+    return m_bCancelled.load(std::memory_order_acquire);
+}
+
+bool CYCancellationState::Register(CYCancellationCallback& callback) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    if (m_bCancelled.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    assert(!callback.m_bRegistered);
+    callback.m_pPrev = nullptr;
+    callback.m_pNext = m_pHead;
+    if (m_pHead != nullptr)
+    {
+        m_pHead->m_pPrev = &callback;
+    }
+
+    m_pHead = &callback;
+    callback.m_bRegistered = true;
+    return true;
+}
+
+void CYCancellationState::Deregister(CYCancellationCallback& callback) noexcept
+{
+    UniqueLock lock(m_lock);
+
+    if (callback.m_bRegistered)
+    {
+        if (callback.m_pPrev != nullptr)
+        {
+            callback.m_pPrev->m_pNext = callback.m_pNext;
+        }
+        else
+        {
+            m_pHead = callback.m_pNext;
+        }
+
+        if (callback.m_pNext != nullptr)
+        {
+            callback.m_pNext->m_pPrev = callback.m_pPrev;
+        }
+
+        callback.m_bRegistered = false;
+        return;
+    }
+
+    if (m_pRunning != &callback)
+    {
+        return;  // never registered, or it ran already
+    }
+
+    if (m_idCanceller == std::this_thread::get_id())
+    {
+        // deregistered from inside OnCancel(), the canceller won't touch it afterwards.
+        *callback.m_pbDeregistered = true;
+        return;
+    }
+
+    lock.unlock();
+
+    // OnCancel() is running on the cancelling thread right now.
+    while (!callback.m_bDone.load(std::memory_order_acquire))
+    {
+        std::this_thread::yield();
+    }
+}
+
+bool CYCancellationState::Cancel() noexcept
+{
+    if (m_bCancelled.exchange(true, std::memory_order_acq_rel))
+    {
+        return false;
+    }
+
+    UniqueLock lock(m_lock);
+    m_idCanceller = std::this_thread::get_id();
+
+    while (m_pHead != nullptr)
+    {
+        const auto pCallback = m_pHead;
+        m_pHead = pCallback->m_pNext;
+        if (m_pHead != nullptr)
+        {
+            m_pHead->m_pPrev = nullptr;
+        }
+
+        bool bDeregistered = false;
+        pCallback->m_bRegistered = false;
+        pCallback->m_pbDeregistered = &bDeregistered;
+        m_pRunning = pCallback;
+        lock.unlock();
+
+        pCallback->OnCancel();
+
+        if (!bDeregistered)
+        {
+            pCallback->m_bDone.store(true, std::memory_order_release);
+        }
+
+        lock.lock();
+        m_pRunning = nullptr;
+    }
+
+    return true;
+}
+
+/*
+    CYCancellationToken
+*/
+CYCancellationToken::CYCancellationToken(SharePtr<CYCancellationState> ptrState) noexcept
+    : m_ptrState(std::move(ptrState))
+{
+}
+
+bool CYCancellationToken::IsCancelled() const noexcept
+{
+    return static_cast<bool>(m_ptrState) && m_ptrState->Cancelled();
+}
+
+bool CYCancellationToken::CanBeCancelled() const noexcept
+{
+    return static_cast<bool>(m_ptrState);
+}
+
+void CYCancellationToken::ThrowIfCancelled() const
+{
+    if (IsCancelled())
+    {
+        throw std::system_error(std::make_error_code(std::errc::operation_canceled), "CYCancellationToken - operation was cancelled.");
+    }
+}
+
+bool CYCancellationToken::Register(CYCancellationCallback& callback) const noexcept
+{
+    if (!static_cast<bool>(m_ptrState))
+    {
+        return true;  // never fires
+    }
+
+    return m_ptrState->Register(callback);
+}
+
+void CYCancellationToken::Deregister(CYCancellationCallback& callback) const noexcept
+{
+    if (static_cast<bool>(m_ptrState))
+    {
+        m_ptrState->Deregister(callback);
+    }
+}
+
+/*
+    CYCancellationSource
+*/
+CYCancellationSource::CYCancellationSource()
+    : m_ptrState(MakeShared<CYCancellationState>())
+{
+}
+
+CYCancellationToken CYCancellationSource::Token() const noexcept
+{
+    return CYCancellationToken(m_ptrState);
+}
+
+bool CYCancellationSource::Cancel() noexcept
+{
+    return m_ptrState->Cancel();
+}
+
+bool CYCancellationSource::IsCancelled() const noexcept
+{
+    return m_ptrState->Cancelled();
+}
+
+CYCOROUTINE_NAMESPACE_END
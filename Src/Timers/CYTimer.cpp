@@ -4,6 +4,7 @@
 #include "CYCoroutine/Timers/CYTimer.hpp"
 #include "CYCoroutine/Timers/CYTimerQueue.hpp"
 #include "CYCoroutine/Executors/CYExecutor.hpp"
+#include "CYCoroutine/Executors/CYThreadPoolExecutor.hpp"
 #include "CYCoroutine/Results/CYResult.hpp"
 
 CYCOROUTINE_NAMESPACE_BEGIN
@@ -24,7 +25,18 @@ CYTimerStateBase::CYTimerStateBase(size_t nDueTime, size_t nFrequency, SharePtr<
 void CYTimerStateBase::Fire()
 {
     const auto nFrequency = m_nFrequency.load(std::memory_order_relaxed);
-    m_tpDeadLine = MakeDeadLine(milliseconds(nFrequency));
+    if (nFrequency == 0)
+    {
+        m_tpDeadLine = MakeDeadLine(milliseconds(0));
+    }
+    else
+    {
+        // the next period counts from the scheduled deadline, not from the firing time, so late
+        // firings don't add up; periods missed entirely are skipped instead of fired back to back.
+        const auto nPeriod = milliseconds(nFrequency);
+        const auto nMissed = (std::max)(ClockType::now() - m_tpDeadLine, ClockType::duration::zero()) / nPeriod;
+        m_tpDeadLine += nPeriod * (nMissed + 1);
+    }
 
     assert(static_cast<bool>(m_ptrExecutor));
 
@@ -88,6 +100,14 @@ void CYTimer::Cancel()
     auto state = std::move(m_ptrState);
     state->Cancel();
 
+    if (state->GetLocalWorker() != static_cast<size_t>(-1))
+    {
+        // kept by a worker of the pool it posts to, not by the timer queue.
+        const auto ptrPool = std::static_pointer_cast<CYThreadPoolExecutor>(state->GetExecutor());
+        ptrPool->RemoveLocalTimer(std::move(state));
+        return;
+    }
+
     auto timerQueue = state->GetTimerQueue().lock();
 
     if (!static_cast<bool>(timerQueue))
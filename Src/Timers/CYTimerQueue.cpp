@@ -1,8 +1,12 @@
 #include "CYCoroutine/CYCoroutineDefine.hpp"
 #include "CYCoroutine/Executors/CYExecutor.hpp"
+#include "CYCoroutine/Executors/CYThreadPoolExecutor.hpp"
+#include "CYCoroutine/Results/CYResumeOn.hpp"
+#include "CYCoroutine/Results/CYSelect.hpp"
 #include "CYCoroutine/Timers/CYTimer.hpp"
 #include "CYCoroutine/Timers/CYTimerQueue.hpp"
 #include "Src/Executors/CYExecutorDefine.hpp"
+#include "Src/Timers/CYTimerWheel.hpp"
 
 #include <set>
 #include <unordered_map>
@@ -154,16 +158,21 @@ namespace
             return (**m_setTimers.begin()).GetDeadLine();
         }
     };
+
+    // bumped by every ShutDown(), pool workers sweep their local timers when it moved.
+    std::atomic_size_t g_nShutdownEpoch{ 0 };
 }  // namespace
 
 //////////////////////////////////////////////////////////////////////////
-CYTimerQueue::CYTimerQueue(milliseconds nMaxWaitTime, const FuncThreadDelegate& funThreadStartedCallback, const FuncThreadDelegate& funThreadTerminatedCallback)
+CYTimerQueue::CYTimerQueue(milliseconds nMaxWaitTime, const FuncThreadDelegate& funThreadStartedCallback, const FuncThreadDelegate& funThreadTerminatedCallback, ETimerQueueBackend eBackend, bool bWorkerLocalTimers)
     : m_funcStartedCallBack(funThreadStartedCallback)
     , m_funcTerminatedCallback(funThreadTerminatedCallback)
     , m_bAtomicAbort(false)
     , m_bAbort(false)
     , m_bIdle(true)
     , m_objMaxWaitingTime(nMaxWaitTime)
+    , m_eBackend(eBackend)
+    , m_bWorkerLocalTimers(bWorkerLocalTimers)
 
 {
 }
@@ -208,10 +217,44 @@ void CYTimerQueue::AddTimer(UniqueLock& lock, TimerPtr ptrNewTimer)
     }
 }
 
+bool CYTimerQueue::AddWorkerLocalTimer(const TimerPtr& ptrNewTimer)
+{
+    if (!m_bWorkerLocalTimers)
+    {
+        return false;
+    }
+
+    // only a pool worker can check a timer between its own tasks, and only one whose pool the
+    // timer posts to, everything else still needs the queue thread.
+    const auto pPool = CYThreadPoolExecutor::CurrentPool();
+    if (pPool == nullptr || pPool != ptrNewTimer->GetExecutor().get())
+    {
+        return false;
+    }
+
+    IfTrueThrow(ShutdownRequested(), TEXT("CYTimerQueue has been shut down."));
+
+    pPool->AddLocalTimer(ptrNewTimer);
+    return true;
+}
+
 void CYTimerQueue::WorkLoop()
 {
-    TimePoint objNextDeadline;
+    if (m_eBackend == ETimerQueueBackend::BACKEND_TIMER_WHEEL)
+    {
+        CYTimerWheel internal_state;
+        WorkLoopImpl(internal_state);
+        return;
+    }
+
     CYTimerQueueInternal internal_state;
+    WorkLoopImpl(internal_state);
+}
+
+template<class INTERNAL_TYPE>
+void CYTimerQueue::WorkLoopImpl(INTERNAL_TYPE& internal_state)
+{
+    TimePoint objNextDeadline;
 
     while (true)
     {
@@ -259,6 +302,11 @@ bool CYTimerQueue::ShutdownRequested() const noexcept
     return m_bAtomicAbort.load(std::memory_order_relaxed);
 }
 
+size_t CYTimerQueue::ShutdownEpoch() noexcept
+{
+    return g_nShutdownEpoch.load(std::memory_order_acquire);
+}
+
 void CYTimerQueue::ShutDown()
 {
     const auto bStateBefore = m_bAtomicAbort.exchange(true, std::memory_order_relaxed);
@@ -267,6 +315,9 @@ void CYTimerQueue::ShutDown()
         return;  // CYTimerQueue has been shut down already.
     }
 
+    // worker-local timers never pass through the queue thread, their workers drop them on seeing this.
+    g_nShutdownEpoch.fetch_add(1, std::memory_order_release);
+
     UniqueLock lock(m_lock);
     m_bAbort = true;
 
@@ -350,9 +401,43 @@ CYLazyResult<void> CYTimerQueue::MakeDelayObject(std::chrono::milliseconds nDueT
     return MakeDelayObjectImpl(nDueTime, shared_from_this(), std::move(ptrExecutor));
 }
 
+CYLazyResult<void> CYTimerQueue::MakeDelayObjectImpl(std::chrono::milliseconds nDueTime, SharePtr<CYTimerQueue> ptrSelf, SharePtr<CYExecutor> ptrExecutor, CYCancellationToken token)
+{
+    // the deadline case removes its timer from the queue as soon as the cancellation wins.
+    const auto nWinner = co_await Select(CYSelectDeadline(std::move(ptrSelf), nDueTime, ptrExecutor), token);
+    if (nWinner == 0)
+    {
+        co_return;
+    }
+
+    // resumed on the cancelling thread, the failure is reported on ptrExecutor like the expiry would be.
+    co_await ResumeOn(ptrExecutor);
+    token.ThrowIfCancelled();
+}
+
+CYLazyResult<void> CYTimerQueue::MakeDelayObject(std::chrono::milliseconds nDueTime, SharePtr<CYExecutor> ptrExecutor, CYCancellationToken token)
+{
+    if (!static_cast<bool>(ptrExecutor))
+    {
+        throw std::invalid_argument("CYTimerQueue::MakeDelayObject() - CYExecutor is null.");
+    }
+
+    return MakeDelayObjectImpl(nDueTime, shared_from_this(), std::move(ptrExecutor), std::move(token));
+}
+
 milliseconds CYTimerQueue::MaxWorkerIdleTime() const noexcept
 {
     return m_objMaxWaitingTime;
 }
 
+ETimerQueueBackend CYTimerQueue::Backend() const noexcept
+{
+    return m_eBackend;
+}
+
+bool CYTimerQueue::WorkerLocalTimers() const noexcept
+{
+    return m_bWorkerLocalTimers;
+}
+
 CYCOROUTINE_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,407 @@
+/*
+ * CYCoroutine License
+ * -----------
+ *
+ * CYCoroutine is licensed under the terms of the MIT license reproduced below.
+ * This means that CYCoroutine is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+/*
+ * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ * VERSION:  1.0.0
+ * PURPOSE:  A cross-platform efficient and stable Coroutine library.
+ * CREATION: 2026.10.18
+ * LCHANGE:  2026.10.18
+ * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+ */
+
+#ifndef __CY_TIMER_WHEEL_CORO_HPP__
+#define __CY_TIMER_WHEEL_CORO_HPP__
+
+#include "CYCoroutine/CYCoroutineDefine.hpp"
+#include "CYCoroutine/Timers/CYTimer.hpp"
+#include "CYCoroutine/Timers/CYTimerQueue.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+#include <cassert>
+
+CYCOROUTINE_NAMESPACE_BEGIN
+
+/*
+ *   timing wheel: a root level of 256 one millisecond slots and four upper levels of 64
+ *   slots each, a level covering 64 times the span of the one below. A timer is linked
+ *   into the slot of its expiry tick relative to the current tick and moves down a level
+ *   whenever the level below wraps around onto its slot (cascading), expired root slots
+ *   are moved to the due list. Every slot is an intrusive list threaded through the
+ *   timer's CYWheelHook, so adding and cancelling never allocate.
+ */
+class CYTimerWheel
+{
+private:
+    static constexpr uint32_t k_nRootBits = 8;
+    static constexpr uint32_t k_nRootSize = 1u << k_nRootBits;
+    static constexpr uint32_t k_nLevelBits = 6;
+    static constexpr uint32_t k_nLevelSize = 1u << k_nLevelBits;
+    static constexpr uint32_t k_nLevels = 4;
+    static constexpr uint32_t k_nDueSlot = k_nRootSize + k_nLevels * k_nLevelSize;
+    static constexpr uint32_t k_nUnlinked = UINT32_MAX;
+    static constexpr uint64_t k_nMaxDelta = (uint64_t(1) << (k_nRootBits + k_nLevels * k_nLevelBits)) - 1;
+
+    const TimePoint m_tpEpoch = ClockType::now();
+    uint64_t m_nCurrent = 0;  // the next tick not processed yet
+    size_t m_nCount = 0;
+
+    CYTimerStateBase* m_arrSlots[k_nDueSlot + 1] = {};
+    uint64_t m_arrOccupied[k_nDueSlot / 64] = {};
+
+    static constexpr uint32_t LevelShift(uint32_t nLevel) noexcept
+    {
+        return k_nRootBits + (nLevel - 1) * k_nLevelBits;
+    }
+
+    static constexpr uint32_t LevelSlot(uint32_t nLevel, uint64_t nTick) noexcept
+    {
+        return k_nRootSize + (nLevel - 1) * k_nLevelSize + static_cast<uint32_t>((nTick >> LevelShift(nLevel)) & (k_nLevelSize - 1));
+    }
+
+    uint64_t TickOf(TimePoint tpDeadLine) const noexcept
+    {
+        // rounded up, a timer never fires before its deadline.
+        return tpDeadLine <= m_tpEpoch ? 0 : static_cast<uint64_t>(std::chrono::ceil<milliseconds>(tpDeadLine - m_tpEpoch).count());
+    }
+
+    uint64_t NowTick(TimePoint now) const noexcept
+    {
+        return now <= m_tpEpoch ? 0 : static_cast<uint64_t>(std::chrono::floor<milliseconds>(now - m_tpEpoch).count());
+    }
+
+    uint32_t SlotOf(uint64_t nTick) const noexcept
+    {
+        if (nTick < m_nCurrent)
+        {
+            return k_nDueSlot;
+        }
+
+        auto nDelta = nTick - m_nCurrent;
+        if (nDelta < k_nRootSize)
+        {
+            return static_cast<uint32_t>(nTick & (k_nRootSize - 1));
+        }
+
+        for (uint32_t nLevel = 1; nLevel < k_nLevels; ++nLevel)
+        {
+            if (nDelta < (uint64_t(1) << LevelShift(nLevel + 1)))
+            {
+                return LevelSlot(nLevel, nTick);
+            }
+        }
+
+        // beyond the top level (~49 days): parked in its last slot, re-placed when cascaded.
+        nDelta = (std::min)(nDelta, k_nMaxDelta);
+        return LevelSlot(k_nLevels, m_nCurrent + nDelta);
+    }
+
+    void Link(CYTimerStateBase* pTimer, uint32_t nSlot) noexcept
+    {
+        auto& hook = pTimer->objWheelHook;
+        hook.pPrev = nullptr;
+        hook.pNext = m_arrSlots[nSlot];
+        hook.nSlot = nSlot;
+
+        if (hook.pNext != nullptr)
+        {
+            hook.pNext->objWheelHook.pPrev = pTimer;
+        }
+
+        m_arrSlots[nSlot] = pTimer;
+        if (nSlot != k_nDueSlot)
+        {
+            m_arrOccupied[nSlot / 64] |= uint64_t(1) << (nSlot % 64);
+        }
+    }
+
+    void Unlink(CYTimerStateBase* pTimer) noexcept
+    {
+        auto& hook = pTimer->objWheelHook;
+        assert(hook.nSlot != k_nUnlinked);
+
+        if (hook.pPrev != nullptr)
+        {
+            hook.pPrev->objWheelHook.pNext = hook.pNext;
+        }
+        else
+        {
+            m_arrSlots[hook.nSlot] = hook.pNext;
+            if (hook.pNext == nullptr && hook.nSlot != k_nDueSlot)
+            {
+                m_arrOccupied[hook.nSlot / 64] &= ~(uint64_t(1) << (hook.nSlot % 64));
+            }
+        }
+
+        if (hook.pNext != nullptr)
+        {
+            hook.pNext->objWheelHook.pPrev = hook.pPrev;
+        }
+
+        hook.pPrev = hook.pNext = nullptr;
+        hook.nSlot = k_nUnlinked;
+    }
+
+    CYTimerStateBase* Detach(uint32_t nSlot) noexcept
+    {
+        m_arrOccupied[nSlot / 64] &= ~(uint64_t(1) << (nSlot % 64));
+        return std::exchange(m_arrSlots[nSlot], nullptr);
+    }
+
+    // re-places the timers of an upper level slot, they all land on lower levels.
+    void Cascade(uint32_t nSlot) noexcept
+    {
+        auto pTimer = Detach(nSlot);
+        while (pTimer != nullptr)
+        {
+            const auto pNext = pTimer->objWheelHook.pNext;
+            Link(pTimer, SlotOf(TickOf(pTimer->GetDeadLine())));
+            pTimer = pNext;
+        }
+    }
+
+    // the first occupied root slot at or after nIndex, k_nRootSize if there is none.
+    uint32_t FindRootSlot(uint32_t nIndex) const noexcept
+    {
+        for (auto nWord = nIndex / 64; nWord < k_nRootSize / 64; ++nWord)
+        {
+            auto nBits = m_arrOccupied[nWord];
+            if (nWord == nIndex / 64)
+            {
+                nBits &= ~uint64_t(0) << (nIndex % 64);
+            }
+
+            if (nBits != 0)
+            {
+                return nWord * 64 + static_cast<uint32_t>(std::countr_zero(nBits));
+            }
+        }
+
+        return k_nRootSize;
+    }
+
+    // the first tick >= nFrom at which a root slot expires or an upper slot cascades.
+    uint64_t NextEventTick(uint64_t nFrom) const noexcept
+    {
+        auto nNext = UINT64_MAX;
+
+        // root slots from the current index on expire in this lap, the ones before it in the next.
+        const auto nRootIndex = static_cast<uint32_t>(nFrom & (k_nRootSize - 1));
+        const auto nRootBase = nFrom - nRootIndex;
+        if (const auto nIndex = FindRootSlot(nRootIndex); nIndex < k_nRootSize)
+        {
+            nNext = nRootBase + nIndex;
+        }
+        else if (const auto nIndex = FindRootSlot(0); nIndex < k_nRootSize)
+        {
+            nNext = nRootBase + k_nRootSize + nIndex;
+        }
+
+        for (uint32_t nLevel = 1; nLevel <= k_nLevels; ++nLevel)
+        {
+            const auto nBits = m_arrOccupied[(k_nRootSize + (nLevel - 1) * k_nLevelSize) / 64];
+            if (nBits == 0)
+            {
+                continue;
+            }
+
+            const auto nShift = LevelShift(nLevel);
+            const auto nBase = ((nFrom + (uint64_t(1) << nShift) - 1) >> nShift) << nShift;
+            const auto nIndex = static_cast<int>((nBase >> nShift) & (k_nLevelSize - 1));
+            const auto nOffset = static_cast<uint64_t>(std::countr_zero(std::rotr(nBits, nIndex)));
+            nNext = (std::min)(nNext, nBase + (nOffset << nShift));
+        }
+
+        return nNext;
+    }
+
+    void Advance(uint64_t nNowTick) noexcept
+    {
+        while (m_nCurrent <= nNowTick)
+        {
+            if ((m_nCurrent & (k_nRootSize - 1)) == 0)
+            {
+                // the root wrapped: cascade level 1, and each level above whose index wrapped too.
+                for (uint32_t nLevel = 1; nLevel <= k_nLevels; ++nLevel)
+                {
+                    const auto nSlot = LevelSlot(nLevel, m_nCurrent);
+                    Cascade(nSlot);
+
+                    if (nSlot != k_nRootSize + (nLevel - 1) * k_nLevelSize)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            auto pTimer = Detach(static_cast<uint32_t>(m_nCurrent & (k_nRootSize - 1)));
+            while (pTimer != nullptr)
+            {
+                const auto pNext = pTimer->objWheelHook.pNext;
+                Link(pTimer, k_nDueSlot);
+                pTimer = pNext;
+            }
+
+            // nothing happens on the ticks in between, jump over them.
+            m_nCurrent = (std::min)(NextEventTick(m_nCurrent + 1), nNowTick + 1);
+        }
+    }
+
+    void ProcessRequestQueue(RequestQueue& queue)
+    {
+        for (auto& request : queue)
+        {
+            if (request.second == ETimerRequest::TYPE_TIMER_REQUEST_ADD)
+            {
+                Insert(std::move(request.first));
+            }
+            else
+            {
+                Remove(request.first.get());
+            }
+        }
+    }
+
+public:
+    CYTimerWheel() noexcept = default;
+    CYTimerWheel(const CYTimerWheel&) = delete;
+    CYTimerWheel& operator=(const CYTimerWheel&) = delete;
+
+    ~CYTimerWheel() noexcept
+    {
+        // the linked timers hold themselves through ptrSelf, break those cycles.
+        for (auto& pHead : m_arrSlots)
+        {
+            while (pHead != nullptr)
+            {
+                Remove(pHead);
+            }
+        }
+    }
+
+    bool Empty() const noexcept
+    {
+        return m_nCount == 0;
+    }
+
+    // nMinTick keeps a re-armed timer out of the round that fired it.
+    void Insert(TimerPtr ptrTimer, uint64_t nMinTick = 0) noexcept
+    {
+        const auto pTimer = ptrTimer.get();
+        assert(pTimer->objWheelHook.nSlot == k_nUnlinked);
+
+        Link(pTimer, SlotOf((std::max)(TickOf(pTimer->GetDeadLine()), nMinTick)));
+        pTimer->objWheelHook.ptrSelf = std::move(ptrTimer);
+        ++m_nCount;
+    }
+
+    void Remove(CYTimerStateBase* pTimer) noexcept
+    {
+        if (pTimer->objWheelHook.nSlot == k_nUnlinked)
+        {
+            return;  // already fired or removed
+        }
+
+        Unlink(pTimer);
+        --m_nCount;
+
+        // may drop the last reference, nothing of pTimer is touched afterwards.
+        auto ptrSelf = std::move(pTimer->objWheelHook.ptrSelf);
+    }
+
+    // cancels and unlinks every timer pred accepts.
+    template<class PREDICATE_TYPE>
+    void RemoveIf(PREDICATE_TYPE pred)
+    {
+        for (auto pHead : m_arrSlots)
+        {
+            auto pTimer = pHead;
+            while (pTimer != nullptr)
+            {
+                const auto pNext = pTimer->objWheelHook.pNext;
+                if (pred(*pTimer))
+                {
+                    pTimer->Cancel();
+                    Remove(pTimer);
+                }
+
+                pTimer = pNext;
+            }
+        }
+    }
+
+    TimePoint ProcessTimers(RequestQueue& queue)
+    {
+        ProcessRequestQueue(queue);
+
+        const auto now = ClockType::now();
+        Advance(NowTick(now));
+
+        while (const auto pTimer = m_arrSlots[k_nDueSlot])
+        {
+            Unlink(pTimer);
+            --m_nCount;
+
+            auto ptrTimer = std::move(pTimer->objWheelHook.ptrSelf);
+
+            // we fire it only if it's not cancelled
+            const auto cancelled = ptrTimer->Cancelled();
+            if (!cancelled)
+            {
+                ptrTimer->Fire();
+            }
+
+            if (!ptrTimer->IsOneShot() && !cancelled)
+            {
+                // a re-armed timer waits for the next round even with a zero frequency.
+                Insert(std::move(ptrTimer), m_nCurrent);
+            }
+        }
+
+        if (m_nCount == 0)
+        {
+            return now + std::chrono::hours(24);
+        }
+
+        const auto nNextTick = NextEventTick(m_nCurrent);
+        assert(nNextTick != UINT64_MAX);
+        return m_tpEpoch + milliseconds(nNextTick);
+    }
+};
+
+CYCOROUTINE_NAMESPACE_END
+
+#endif //__CY_TIMER_WHEEL_CORO_HPP__